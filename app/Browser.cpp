@@ -0,0 +1,599 @@
+#include "Browser.h"
+#include "TreeModel.h"
+#include "SlotModelBuilder.h"
+#include "ConnectionWidget.h"
+#include "NameTable.h"
+#include "SearchIndex.h"
+#include "ClassHierarchy.h"
+#include "PagedTableModel.h"
+#include "ConnectionPool.h"
+#include "DatabaseDiff.h"
+#include "Exporter.h"
+#include "HierarchyView.h"
+#include "LiveDatabase.h"
+
+#include <QtWidgets>
+#include <QtSql>
+
+#include <iostream>
+
+Browser::Browser(QWidget *parent)
+    : QWidget(parent), liveDb(0)
+{
+    setupUi(this);
+
+    slotViews.clear();
+
+    if (QSqlDatabase::drivers().isEmpty())
+        QMessageBox::information(this, tr("No database drivers found"),
+                                 tr("This demo requires at least one Qt database driver. "
+                                    "Please check the documentation how to build the "
+                                    "Qt SQL plugins."));
+
+    emit statusMessage(tr("Ready."));
+}
+
+Browser::~Browser()
+{
+   delete liveDb;
+}
+
+void Browser::closeEvent(QCloseEvent* event)
+{
+   closeAllConnections();
+   QWidget::closeEvent(event);
+}
+
+QSqlError Browser::addConnection(const QString &driver, const QString &dbName)
+{
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    QSqlError err;
+    if (!db.isOpen()) {
+       db = QSqlDatabase::addDatabase(driver, dbName);
+       db.setDatabaseName(dbName);
+       // lets the parser attach its (uri named) staging database when publishing
+       db.setConnectOptions("QSQLITE_OPEN_URI");
+       if (!db.open()) {
+           err = db.lastError();
+           db = QSqlDatabase();
+           QSqlDatabase::removeDatabase(dbName);
+       }
+       else ConnectionPool::instance().addDatabase(db);
+    }
+    else {
+       db = QSqlDatabase();
+      err.setType(QSqlError::UnknownError);
+    }
+    return err;
+}
+
+void Browser::openConnection()
+{
+   QStringList names = QFileDialog::getOpenFileNames(this, "Open Database", "/home", "*.sqlite");
+   for (int i = 0; i < names.size(); i++) {
+      QString name = names[i];
+      QSqlError err = addConnection("QSQLITE", name);
+      if (err.type() != QSqlError::NoError) {
+           QMessageBox::warning(this, tr("Unable to open database"), tr("An error occurred while "
+                                       "opening the connection: ") + err.text());
+      }
+   }
+   connectionWidget->refresh();
+}
+
+void Browser::createConnection()
+{
+   QString dir = QFileDialog::getExistingDirectory(this, tr("Open OE Directory to Parse"),
+                                                    "/home",
+                                                    QFileDialog::ShowDirsOnly
+                                                    | QFileDialog::DontResolveSymlinks);
+
+   QString name = QFileDialog::getSaveFileName(this, "Create New Database Name", "/home", "*.sqlite");
+
+   if (!dir.isEmpty() && !name.isEmpty()) {
+      if (!name.endsWith(".sqlite")) name.append(".sqlite");
+      QSqlError err = addConnection("QSQLITE", name);
+      if (err.type() != QSqlError::NoError) {
+         QMessageBox::warning(this, tr("Unable to open database"), tr("An error occurred while "
+                                    "opening the connection: ") + err.text());
+      }
+      else {
+         // the table models can hold statements open on the write connection, which would stop
+         // the parser publishing over the tables
+         QAbstractItemModel* oldModel = table->model();
+         table->setModel(0);
+         delete oldModel;
+         sqlConsole->clear();
+         // while parsing, the sql console stays usable (against the parse so far, as "live"), and
+         // everything else waits
+         QMenuBar* menuBar = window()->findChild<QMenuBar*>();
+         if (menuBar) menuBar->setEnabled(false);
+         leftPane->setEnabled(false);
+         table->setEnabled(false);
+         QProgressDialog progressDialog(this);
+         progressDialog.setMaximum(0);
+         connect(&myParser, SIGNAL(phaseStarted(QString)), &progressDialog, SLOT(setWindowTitle(QString)));
+         connect(&myParser, SIGNAL(progress(int)), this, SLOT(parseProgress()));
+         connect(&myParser, SIGNAL(stagingOpened(QString,QString)), this, SLOT(openLiveDatabase(QString,QString)));
+         connect(&myParser, SIGNAL(stagingClosed()), this, SLOT(closeLiveDatabase()));
+         connect(&progressDialog, SIGNAL(canceled()), &myParser, SLOT(cancel()));
+         progressDialog.show();
+         const Parser::Result result = myParser.parse(dir, name);
+         myParser.disconnect(this);
+         closeLiveDatabase();
+         progressDialog.close();
+         if (menuBar) menuBar->setEnabled(true);
+         leftPane->setEnabled(true);
+         table->setEnabled(true);
+
+         if (result == Parser::Canceled) {
+            QMessageBox::information(this, "PARSING STOPPED", "Parsing was cancelled by user");
+         }
+         else if (result == Parser::Failed) {
+            QMessageBox::warning(this, "PARSING FAILED", "Unable to write the parsed data to " + name);
+         }
+         else {
+            QMessageBox::information(this, "PARSING COMPLETE", QString("Files parsed: %1 (%2 skipped by the prefilter, %3%)")
+                                     .arg(myParser.filesParsed()).arg(myParser.filesSkipped())
+                                     .arg(myParser.filesParsed() ? 100 * myParser.filesSkipped() / myParser.filesParsed() : 0));
+         }
+         connectionWidget->refresh();
+      }
+   }
+}
+
+// closes the selected database
+void Browser::closeConnection()
+{
+   QString dbName = connectionWidget->currDatabaseName();
+   if (!dbName.isEmpty()) {
+      int sIdx = dbName.lastIndexOf("/") + 1;
+      QString temp = dbName.right(dbName.length() - sIdx);
+      sqlConsole->clear();
+      ConnectionPool::instance().removeDatabase(dbName);
+      QSqlDatabase::removeDatabase(dbName);
+      bool found = false;
+      for (int i = 0; i < slotViews.size() && !found; i++) {
+         if (slotViews[i]->windowTitle() == temp) {
+            found = true;
+            slotViews[i]->close();
+            slotViews.removeAt(i);
+         }
+      }
+      connectionWidget->refresh();
+   }
+}
+
+void Browser::closeAllConnections()
+{
+   // close all views
+   while (!slotViews.isEmpty()) {
+      QTreeView* view = slotViews.first();
+      view->close();
+      slotViews.removeFirst();
+   }
+
+   sqlConsole->clear();
+   QStringList dbNames = ConnectionWidget::databaseNames();
+   for (int i = 0; i < dbNames.size(); i++) {
+      QString dbName = dbNames[i];
+      if (!dbName.isEmpty()) {
+         int sIdx = dbName.lastIndexOf("/") + 1;
+         QString temp = dbName.right(dbName.length() - sIdx);
+         ConnectionPool::instance().removeDatabase(dbName);
+         QSqlDatabase::removeDatabase(dbName);
+      }
+   }
+   connectionWidget->refresh();
+}
+
+
+
+void Browser::showTable(const QString &t)
+{
+    QSqlDatabase db = connectionWidget->currentDatabase();
+    QString tableName = db.driver()->escapeIdentifier(t, QSqlDriver::TableName);
+    QAbstractItemModel* oldModel = table->model();
+
+    // the slot tables can get very large, so page through them (read only) rather than
+    // joining and loading them whole
+    if (tableName == "\"slotTable\"" || tableName == "\"slotObjTable\"") {
+       PagedTableModel* model = new PagedTableModel(table, ConnectionPool::instance().reader(connectionWidget->currDatabaseName()));
+       model->setTable(tableName);
+       if (tableName == "\"slotTable\"") {
+          model->setHeaderData(0, Qt::Horizontal, "ID");
+          model->setHeaderData(1, Qt::Horizontal, "SLOT NAME");
+          model->setHeaderData(2, Qt::Horizontal, "PARENT OBJECT");
+          model->setHeaderData(3, Qt::Horizontal, "SLOT INDEX");
+          model->setRelation(2, "class", "id", "className");
+       }
+       else {
+          model->setHeaderData(0, Qt::Horizontal, "SLOT ID");
+          model->setHeaderData(1, Qt::Horizontal, "OBJECT TYPE");
+          model->setRelation(0, "slotTable", "slotId", "slotName");
+          model->setRelation(1, "class", "id", "className");
+       }
+       if (!model->select())
+           emit statusMessage(model->lastError().text());
+       table->setModel(model);
+       table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+       delete oldModel;
+       return;
+    }
+
+    CustomModel* model = new CustomModel(table, db);
+    model->setEditStrategy(QSqlTableModel::OnRowChange);
+    model->setTable(tableName);
+    // OE specific relationships
+    if (tableName == "\"class\"") {
+       // set our headers
+       model->setHeaderData(0, Qt::Horizontal, "ID");
+       model->setHeaderData(1, Qt::Horizontal, "CLASS NAME");
+       model->setHeaderData(2, Qt::Horizontal, "FORM NAME");
+       model->setHeaderData(3, Qt::Horizontal, "FILE NAME");
+       model->setHeaderData(4, Qt::Horizontal, "BASECLASS");
+       model->setJoinMode(QSqlRelationalTableModel::LeftJoin);
+       model->setRelation(4, QSqlRelation("class", "id", "className"));
+    }
+    model->select();
+    if (model->lastError().type() != QSqlError::NoError)
+        emit statusMessage(model->lastError().text());
+    table->setModel(model);
+    table->setEditTriggers(QAbstractItemView::DoubleClicked|QAbstractItemView::EditKeyPressed);
+    delete oldModel;
+}
+
+
+
+void Browser::about()
+{
+    QMessageBox::about(this, tr("About"), tr("Browser to parse and view OpenEaagles files using Sqlite."));
+}
+
+
+// Each database's tree is built on a worker thread.  The views are shown straight away, and fill in
+// as the classes stream in.
+void Browser::viewObjectsAndSlots()
+{
+   // get all the databases, and build views for each
+   QStringList strings = ConnectionWidget::databaseNames();
+   for (int i = 0; i < strings.size(); i++) {
+      QSqlDatabase db = ConnectionPool::instance().writer(strings[i]);
+      if (db.isOpen()) {
+         // databases parsed before we had inheritance need it built first
+         if (!ClassHierarchy::exists(db)) ClassHierarchy::build(db);
+
+         QTreeView* sv = findSlotView(strings[i]);
+         if (sv == 0) {
+            QString temp = strings[i];
+            // we only want the file name!
+            int sIdx = temp.lastIndexOf("/") + 1;
+            temp = temp.right(temp.length() - sIdx);
+            sv = new QTreeView();
+            sv->setWindowTitle(temp);
+            sv->resize(300, 300);
+            sv->setContextMenuPolicy(Qt::ActionsContextMenu);
+            QAction* acceptsAction = new QAction(tr("Slots Accepting This Class"), sv);
+            connect(acceptsAction, SIGNAL(triggered()), this, SLOT(showAcceptingSlots()));
+            sv->addAction(acceptsAction);
+            slotViews << sv;
+         }
+
+         // replacing the old model also stops it loading, if it still was
+         QAbstractItemModel* oldModel = sv->model();
+         TreeModel* model = new TreeModel(sv);
+         sv->setModel(model);
+         delete oldModel;
+         sv->show();
+         sv->activateWindow();
+
+         SlotModelBuilder* builder = new SlotModelBuilder(strings[i], model);
+         connect(builder, SIGNAL(finished(QString,int)), this, SLOT(slotModelFinished(QString,int)));
+         QThreadPool::globalInstance()->start(builder);
+      }
+   }
+}
+
+// keeps the progress dialog (and its cancel button) alive while the parser runs
+void Browser::parseProgress()
+{
+   qApp->processEvents();
+}
+
+// lets the sql console query the parse as it goes
+void Browser::openLiveDatabase(const QString &dbName, const QString &stagingUri)
+{
+   closeLiveDatabase();
+   liveDb = new LiveDatabase(dbName, stagingUri);
+   if (liveDb->isOpen()) {
+      emit statusMessage(tr("Parsing - the parse so far can be queried in the SQL console as %1.class, %1.slotTable and %1.slotObjTable")
+                         .arg(LiveDatabase::SCHEMA));
+   }
+}
+
+// the parser is done with the files, so the console has to let go of the parse (and any results
+// still reading it)
+void Browser::closeLiveDatabase()
+{
+   if (liveDb == 0) return;
+   sqlConsole->clear();
+   delete liveDb;
+   liveDb = 0;
+   emit statusMessage(tr("Ready."));
+}
+
+void Browser::slotModelFinished(const QString& dbName, const int numClasses)
+{
+   emit statusMessage(tr("Loaded %1 classes from %2").arg(numClasses).arg(dbName));
+}
+
+QTreeView* Browser::findSlotView(const QString &dbName) const
+{
+   // the views are titled with just the file name
+   int sIdx = dbName.lastIndexOf("/") + 1;
+   QString temp = dbName.right(dbName.length() - sIdx);
+   for (int i = 0; i < slotViews.size(); i++) {
+      if (slotViews[i]->windowTitle() == temp) return slotViews[i];
+   }
+   return 0;
+}
+
+// type-ahead search of the current database
+void Browser::on_searchEdit_textChanged(const QString &text)
+{
+   searchResults->clear();
+   QSqlDatabase db = ConnectionPool::instance().reader(connectionWidget->currDatabaseName());
+   if (!db.isOpen() || text.trimmed().isEmpty()) return;
+
+   // databases parsed before we had searching won't have an index yet
+   if (!SearchIndex::exists(db)) {
+      emit statusMessage(tr("Building search index..."));
+      SearchIndex::build(connectionWidget->currentDatabase());
+   }
+
+   QElapsedTimer timer;
+   timer.start();
+   const QList<SearchIndex::Match> matches = SearchIndex::search(db, text);
+   for (int i = 0; i < matches.size(); i++) {
+      const SearchIndex::Match& match = matches[i];
+      QString label = match.name;
+      if (match.kind == SearchIndex::FormName) label = tr("%1 (form of %2)").arg(match.name, match.owner);
+      else if (match.kind == SearchIndex::SlotName) label = tr("%1 (slot of %2)").arg(match.name, match.owner);
+      QListWidgetItem* item = new QListWidgetItem(label, searchResults);
+      item->setData(Qt::UserRole, match.kind);
+      item->setData(Qt::UserRole + 1, match.id);
+      item->setData(Qt::UserRole + 2, match.name);
+      item->setData(Qt::UserRole + 3, match.owner);
+   }
+   emit statusMessage(tr("%1 matches in %2 ms").arg(matches.size()).arg(timer.elapsed()));
+}
+
+// jump to the match, in the table and in the slot view
+void Browser::on_searchResults_itemActivated(QListWidgetItem *item)
+{
+   if (!item) return;
+
+   const int kind = item->data(Qt::UserRole).toInt();
+   const qint64 id = item->data(Qt::UserRole + 1).toLongLong();
+   const QString name = item->data(Qt::UserRole + 2).toString();
+   const QString owner = item->data(Qt::UserRole + 3).toString();
+   if (kind == SearchIndex::SlotName) {
+      showTable("slotTable");
+      selectTableRow(id);
+      selectInSlotView(owner, name);
+   }
+   else {
+      showTable("class");
+      selectTableRow(id);
+      selectInSlotView(kind == SearchIndex::ClassName ? name : owner, QString());
+   }
+}
+
+void Browser::selectTableRow(const qint64 id)
+{
+   QAbstractItemModel* model = table->model();
+   if (!model) return;
+
+   // paged tables can find the row directly (slotTable's ids are its rowids)
+   PagedTableModel* paged = qobject_cast<PagedTableModel*>(model);
+   if (paged) {
+      const int row = paged->findRow(id);
+      if (row >= 0) {
+         QModelIndex idx = paged->index(row, 0);
+         table->setCurrentIndex(idx);
+         table->scrollTo(idx);
+      }
+      return;
+   }
+
+   for (int row = 0; ; row++) {
+      // the sql models fetch lazily
+      while (row >= model->rowCount() && model->canFetchMore(QModelIndex())) {
+         model->fetchMore(QModelIndex());
+      }
+      if (row >= model->rowCount()) return;
+
+      QModelIndex idx = model->index(row, 0);
+      if (model->data(idx).toLongLong() == id) {
+         table->setCurrentIndex(idx);
+         table->scrollTo(idx);
+         return;
+      }
+   }
+}
+
+void Browser::selectInSlotView(const QString &className, const QString &slotName)
+{
+   QTreeView* sv = findSlotView(connectionWidget->currDatabaseName());
+   TreeModel* model = (sv != 0 ? qobject_cast<TreeModel*>(sv->model()) : 0);
+   if (model == 0) return;
+
+   NameTable& names = NameTable::instance();
+   QModelIndex idx = model->findClass(names.find(className));
+   if (idx.isValid() && !slotName.isEmpty()) {
+      QModelIndex slotIdx = model->findSlot(idx, names.find(slotName));
+      if (slotIdx.isValid()) idx = slotIdx;
+   }
+   if (idx.isValid()) {
+      sv->setCurrentIndex(idx);
+      sv->scrollTo(idx);
+      sv->show();
+      sv->activateWindow();
+   }
+}
+
+// compares another open database (the older one) against the current one, listing what changed
+void Browser::compareDatabases()
+{
+   const QString newName = connectionWidget->currDatabaseName();
+   QStringList others = ConnectionWidget::databaseNames();
+   others.removeAll(newName);
+   if (newName.isEmpty() || others.isEmpty()) {
+      QMessageBox::information(this, tr("Compare Databases"), tr("Open at least two databases, and select the newer one."));
+      return;
+   }
+   bool ok = false;
+   const QString oldName = QInputDialog::getItem(this, tr("Compare Databases"), tr("Compare %1 against:").arg(newName),
+                                                 others, 0, false, &ok);
+   if (!ok) return;
+
+   QApplication::setOverrideCursor(Qt::WaitCursor);
+   QElapsedTimer timer;
+   timer.start();
+   ConnectionPool& pool = ConnectionPool::instance();
+   const QList<DatabaseDiff::Change> changes = DatabaseDiff::compare(pool.reader(oldName), pool.reader(newName));
+   const qint64 elapsed = timer.elapsed();
+   QApplication::restoreOverrideCursor();
+
+   static const char* hows[] = { QT_TR_NOOP("added"), QT_TR_NOOP("removed"), QT_TR_NOOP("changed") };
+   static const char* whats[] = { QT_TR_NOOP("class"), QT_TR_NOOP("base class"), QT_TR_NOOP("form name"),
+                                  QT_TR_NOOP("slot"), QT_TR_NOOP("slot type") };
+   QList<QTreeWidgetItem*> items;
+   for (int i = 0; i < changes.size(); i++) {
+      const DatabaseDiff::Change& change = changes[i];
+      items << new QTreeWidgetItem(QStringList() << tr(hows[change.how]) << tr(whats[change.what])
+                                   << change.name << change.oldValue << change.newValue);
+   }
+
+   QTreeWidget* view = new QTreeWidget();
+   view->setAttribute(Qt::WA_DeleteOnClose);
+   view->setWindowTitle(tr("%1 -> %2").arg(QFileInfo(oldName).fileName(), QFileInfo(newName).fileName()));
+   view->setHeaderLabels(QStringList() << tr("change") << tr("what") << tr("name") << tr("old") << tr("new"));
+   view->setRootIsDecorated(false);
+   view->addTopLevelItems(items);
+   view->setSortingEnabled(true);
+   view->resize(700, 400);
+   view->show();
+   emit statusMessage(tr("%1 changes (%2 ms)").arg(changes.size()).arg(elapsed));
+}
+
+// streams a table of the current database out to a csv or json file (in the background)
+void Browser::exportDatabase()
+{
+   const QString dbName = connectionWidget->currDatabaseName();
+   if (dbName.isEmpty()) {
+      QMessageBox::information(this, tr("Export"), tr("Select a database to export."));
+      return;
+   }
+   static const char* names[] = { QT_TR_NOOP("Classes"), QT_TR_NOOP("Slots"), QT_TR_NOOP("Slot Types") };
+   QStringList items;
+   for (int i = 0; i < 3; i++) items << tr(names[i]);
+   bool ok = false;
+   const QString item = QInputDialog::getItem(this, tr("Export"), tr("Export from %1:").arg(QFileInfo(dbName).fileName()),
+                                              items, 0, false, &ok);
+   if (!ok) return;
+
+   const QString fileName = QFileDialog::getSaveFileName(this, tr("Export"), QString(),
+                                                         tr("CSV files (*.csv);;JSON files (*.json)"));
+   if (fileName.isEmpty()) return;
+   Exporter::Format format;
+   if (!Exporter::formatFromName(fileName, format)) {
+      QMessageBox::warning(this, tr("Export"), tr("Export to a .csv or .json file."));
+      return;
+   }
+
+   ExportTask* task = new ExportTask(dbName, Exporter::Data(items.indexOf(item)), format, fileName);
+   connect(task, SIGNAL(finished(QString,qint64)), this, SLOT(exportFinished(QString,qint64)));
+   QThreadPool::globalInstance()->start(task);
+   emit statusMessage(tr("Exporting to %1...").arg(fileName));
+}
+
+void Browser::exportFinished(const QString &fileName, const qint64 rows)
+{
+   if (rows < 0) emit statusMessage(tr("Unable to export to %1").arg(fileName));
+   else emit statusMessage(tr("Exported %1 rows to %2").arg(rows).arg(fileName));
+}
+
+// draws the current database's class inheritance as a graph (laid out in the background)
+void Browser::viewClassHierarchy()
+{
+   const QString dbName = connectionWidget->currDatabaseName();
+   if (dbName.isEmpty()) return;
+
+   HierarchyView* view = new HierarchyView();
+   view->setAttribute(Qt::WA_DeleteOnClose);
+   view->setWindowTitle(tr("%1 - Class Hierarchy").arg(QFileInfo(dbName).fileName()));
+   view->resize(900, 600);
+   connect(view, SIGNAL(classActivated(QString)), this, SLOT(showClass(QString)));
+   view->show();
+
+   HierarchyLoader* loader = new HierarchyLoader(dbName);
+   connect(loader, SIGNAL(loaded(HierarchyLayout)), view, SLOT(setHierarchy(HierarchyLayout)));
+   QThreadPool::globalInstance()->start(loader);
+}
+
+void Browser::showClass(const QString &className)
+{
+   selectInSlotView(className, QString());
+}
+
+// runs the console's sql on the write connection, so it can create (and drop) indexes too
+void Browser::on_sqlConsole_runRequested(const QString &sql, const bool explainOnly)
+{
+   if (liveDb && liveDb->isOpen()) sqlConsole->exec(liveDb->database(), sql, explainOnly);
+   else sqlConsole->exec(connectionWidget->currentDatabase(), sql, explainOnly);
+}
+
+// lists every slot (in the slot view's database) that the current class can be given to, because it
+// asks for the class or one of its base classes
+void Browser::showAcceptingSlots()
+{
+   QAction* action = qobject_cast<QAction*>(sender());
+   QTreeView* sv = (action ? qobject_cast<QTreeView*>(action->parent()) : 0);
+   if (sv == 0 || !sv->currentIndex().isValid()) return;
+
+   // the class the current slot (or slot type) belongs to
+   QModelIndex idx = sv->currentIndex();
+   while (idx.parent().isValid()) idx = idx.parent();
+   const QString className = idx.data().toString();
+
+   QString dbName;
+   const QStringList dbNames = ConnectionWidget::databaseNames();
+   for (int i = 0; i < dbNames.size() && dbName.isEmpty(); i++) {
+      if (findSlotView(dbNames[i]) == sv) dbName = dbNames[i];
+   }
+   if (dbName.isEmpty()) return;
+
+   QElapsedTimer timer;
+   timer.start();
+   const QList<ClassHierarchy::Acceptor> found = ClassHierarchy::acceptors(ConnectionPool::instance().reader(dbName), className);
+   const qint64 elapsed = timer.nsecsElapsed() / 1000;
+
+   QList<QTreeWidgetItem*> items;
+   for (int i = 0; i < found.size(); i++) {
+      QTreeWidgetItem* item = new QTreeWidgetItem(QStringList() << found[i].owner << found[i].slot << found[i].type);
+      item->setData(3, Qt::DisplayRole, found[i].depth);
+      items << item;
+   }
+   QTreeWidget* view = new QTreeWidget();
+   view->setAttribute(Qt::WA_DeleteOnClose);
+   view->setWindowTitle(tr("Slots accepting %1").arg(className));
+   view->setHeaderLabels(QStringList() << tr("class") << tr("slot") << tr("accepts") << tr("levels up"));
+   view->setRootIsDecorated(false);
+   view->addTopLevelItems(items);
+   view->setSortingEnabled(true);
+   view->sortByColumn(3, Qt::AscendingOrder);
+   view->resize(600, 400);
+   view->show();
+   emit statusMessage(tr("%1 slots accept %2 (%3 us)").arg(found.size()).arg(className).arg(elapsed));
+}
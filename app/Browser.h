@@ -8,10 +8,12 @@
 #include "Parser.h"
 
 class ConnectionWidget;
+class LiveDatabase;
 QT_FORWARD_DECLARE_CLASS(QTableView)
 QT_FORWARD_DECLARE_CLASS(QPushButton)
 QT_FORWARD_DECLARE_CLASS(QTextEdit)
 QT_FORWARD_DECLARE_CLASS(QSqlError)
+QT_FORWARD_DECLARE_CLASS(QListWidgetItem)
 
 class Browser: public QWidget, private Ui::Browser
 {
@@ -33,6 +35,21 @@ public slots:
     void on_connectionWidget_tableActivated(const QString &table)
     { showTable(table); }
     void viewObjectsAndSlots();
+    void compareDatabases();
+    void exportDatabase();
+    void viewClassHierarchy();
+
+private slots:
+    void parseProgress();
+    void openLiveDatabase(const QString &dbName, const QString &stagingUri);
+    void closeLiveDatabase();
+    void showClass(const QString &className);
+    void showAcceptingSlots();
+    void slotModelFinished(const QString &dbName, const int numClasses);
+    void exportFinished(const QString &fileName, const qint64 rows);
+    void on_searchEdit_textChanged(const QString &text);
+    void on_searchResults_itemActivated(QListWidgetItem *item);
+    void on_sqlConsole_runRequested(const QString &sql, const bool explainOnly);
 
 signals:
     void statusMessage(const QString &message);
@@ -41,8 +58,16 @@ protected:
    virtual void closeEvent(QCloseEvent* event);
 
 private:
+    // the slot view of the given database, if we have one
+    QTreeView* findSlotView(const QString &dbName) const;
+    // selects the row in the table view with the given id (first column)
+    void selectTableRow(const qint64 id);
+    // selects the class (and slot, if given) in the current database's slot view
+    void selectInSlotView(const QString &className, const QString &slotName);
+
     // our parser
     Parser myParser;
+    LiveDatabase* liveDb;             // the parse in progress, for the sql console (if parsing)
     QList<QTreeView*> slotViews;      // holds our summary slot views for each table
 };
 
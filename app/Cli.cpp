@@ -0,0 +1,331 @@
+#include "Cli.h"
+#include "CatalogHeader.h"
+#include "ClassHierarchy.h"
+#include "ConnectionPool.h"
+#include "Parser.h"
+#include "DatabaseDiff.h"
+#include "Exporter.h"
+#include "InputChecker.h"
+#include "KeywordMatcher.h"
+#include "LanguageServer.h"
+
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSqlError>
+#include <QTextStream>
+
+#include <cstdio>
+#include <iostream>
+
+bool Cli::isCommand(int argc, char* argv[])
+{
+   return (argc > 1 && QString(argv[1]).startsWith("--"));
+}
+
+int Cli::run(const QStringList& args)
+{
+   const QString command = args.value(0);
+   if (command == "--parse") return parse(args.mid(1));
+   if (command == "--diff") return diff(args.mid(1));
+   if (command == "--lint") return lint(args.mid(1));
+   if (command == "--header") return header(args.mid(1));
+   if (command == "--accepts") return accepts(args.mid(1));
+   if (command == "--bench-keywords") return benchKeywords(args.mid(1));
+   if (command == "--export") return exportData(args.mid(1));
+   if (command == "--lsp") return lsp(args.mid(1));
+   return usage();
+}
+
+int Cli::usage()
+{
+   std::cerr << "usage: oeSql                                 (start the browser)" << std::endl
+             << "       oeSql --parse <sourceDir> <db.sqlite> [trace.json]" << std::endl
+             << "       oeSql --diff <old.sqlite> <new.sqlite>" << std::endl
+             << "       oeSql --lint <db.sqlite> <file.epp|file.edl|dir>..." << std::endl
+             << "       oeSql --header <db.sqlite> <out.h> [namespace]" << std::endl
+             << "       oeSql --accepts <db.sqlite> <className|formName>" << std::endl
+             << "       oeSql --export <db.sqlite> <classes|slots|slottypes> <csv|json> [file]" << std::endl
+             << "       oeSql --bench-keywords <sourceDir>" << std::endl
+             << "       oeSql --lsp <db.sqlite>               (language server on stdin/stdout)" << std::endl;
+   return 2;
+}
+
+QSqlDatabase Cli::openDatabase(const QString& fileName)
+{
+   QSqlDatabase db;
+   if (!QFileInfo(fileName).exists()) {
+      std::cerr << "no such database: " << fileName.toStdString() << std::endl;
+      return db;
+   }
+   db = QSqlDatabase::addDatabase("QSQLITE", fileName);
+   db.setDatabaseName(fileName);
+   db.setConnectOptions("QSQLITE_OPEN_READONLY");
+   if (!db.open()) {
+      std::cerr << "unable to open " << fileName.toStdString() << ": " << db.lastError().text().toStdString() << std::endl;
+   }
+   return db;
+}
+
+// --parse <sourceDir> <db> [trace]
+// parses the source tree into the database (created if need be), as File > Add Database does,
+// optionally writing a trace of the parse (for chrome://tracing or ui.perfetto.dev)
+int Cli::parse(const QStringList& args)
+{
+   if (args.size() != 2 && args.size() != 3) return usage();
+
+   QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", args[1]);
+   db.setDatabaseName(args[1]);
+   // the parser attaches its (uri named) staging database when publishing
+   db.setConnectOptions("QSQLITE_OPEN_URI");
+   if (!db.open()) {
+      std::cerr << "unable to open " << args[1].toStdString() << ": " << db.lastError().text().toStdString() << std::endl;
+      return 2;
+   }
+   ConnectionPool::instance().addDatabase(db);
+
+   QElapsedTimer timer;
+   timer.start();
+   Parser parser;
+   if (args.size() == 3) parser.setTraceFile(args[2]);
+   const Parser::Result result = parser.parse(args[0], args[1]);
+   if (result != Parser::Parsed) {
+      std::cerr << "unable to write the parsed data to " << args[1].toStdString() << std::endl;
+      return 1;
+   }
+   std::cerr << parser.filesParsed() << " files parsed, " << parser.filesSkipped() << " skipped by the prefilter ("
+             << (parser.filesParsed() ? 100 * parser.filesSkipped() / parser.filesParsed() : 0) << "%, "
+             << timer.elapsed() << " ms)" << std::endl;
+   return 0;
+}
+
+// --diff <old> <new>
+// prints one line per change, then a summary; exits 1 if anything changed
+int Cli::diff(const QStringList& args)
+{
+   if (args.size() != 2) return usage();
+
+   QSqlDatabase oldDb = openDatabase(args[0]);
+   QSqlDatabase newDb = openDatabase(args[1]);
+   if (!oldDb.isOpen() || !newDb.isOpen()) return 2;
+
+   QElapsedTimer timer;
+   timer.start();
+   const QList<DatabaseDiff::Change> changes = DatabaseDiff::compare(oldDb, newDb);
+
+   QTextStream out(stdout);
+   int counts[3] = { 0, 0, 0 };
+   for (int i = 0; i < changes.size(); i++) {
+      out << DatabaseDiff::describe(changes[i]) << "\n";
+      counts[changes[i].how]++;
+   }
+   out << QString("%1 added, %2 removed, %3 changed (%4 ms)\n")
+          .arg(counts[DatabaseDiff::Added]).arg(counts[DatabaseDiff::Removed])
+          .arg(counts[DatabaseDiff::Changed]).arg(timer.elapsed());
+   return (changes.isEmpty() ? 0 : 1);
+}
+
+// --export <db> <classes|slots|slottypes> <csv|json> [file]
+// streams the table out to the file (or stdout)
+int Cli::exportData(const QStringList& args)
+{
+   if (args.size() != 3 && args.size() != 4) return usage();
+
+   Exporter::Data data;
+   Exporter::Format format;
+   if (!Exporter::dataFromName(args[1], data) || !Exporter::formatFromName(args[2], format)) return usage();
+
+   QSqlDatabase db = openDatabase(args[0]);
+   if (!db.isOpen()) return 2;
+
+   QFile file;
+   bool opened = false;
+   if (args.size() == 4) {
+      file.setFileName(args[3]);
+      opened = file.open(QFile::WriteOnly | QFile::Truncate);
+   }
+   else opened = file.open(stdout, QFile::WriteOnly);
+   if (!opened) {
+      std::cerr << "unable to write " << args.value(3, "stdout").toStdString() << std::endl;
+      return 2;
+   }
+
+   QElapsedTimer timer;
+   timer.start();
+   QString error;
+   const qint64 rows = Exporter::write(db, data, format, &file, &error);
+   file.close();
+   if (rows < 0) {
+      std::cerr << "export failed: " << error.toStdString() << std::endl;
+      return 1;
+   }
+   std::cerr << rows << " rows (" << timer.elapsed() << " ms)" << std::endl;
+   return 0;
+}
+
+// --lint <db> <file|dir>...
+// checks the input files (directories are searched for .epp and .edl files), printing
+// "file:line: problem" for each; exits 1 if there were any
+int Cli::lint(const QStringList& args)
+{
+   if (args.size() < 2) return usage();
+
+   QSqlDatabase db = openDatabase(args[0]);
+   if (!db.isOpen()) return 2;
+
+   QElapsedTimer timer;
+   timer.start();
+   InputChecker checker;
+   if (!checker.load(db)) {
+      std::cerr << args[0].toStdString() << " isn't a parsed database" << std::endl;
+      return 2;
+   }
+   const QStringList files = InputChecker::findInputFiles(args.mid(1));
+   const QList<InputChecker::Problem> problems = checker.check(files);
+
+   QTextStream out(stdout);
+   for (int i = 0; i < problems.size(); i++) {
+      out << problems[i].fileName << ":" << problems[i].line << ": " << problems[i].message << "\n";
+   }
+   out.flush();
+   std::cerr << files.size() << " files, " << problems.size() << " problems (" << timer.elapsed() << " ms)" << std::endl;
+   return (problems.isEmpty() ? 0 : 1);
+}
+
+// --lsp <db>
+// serves completion, hover and diagnostics for input files to an editor, over stdin and stdout
+// (the language server protocol); anything we have to say goes to stderr
+int Cli::lsp(const QStringList& args)
+{
+   if (args.size() != 1) return usage();
+
+   QSqlDatabase db = openDatabase(args[0]);
+   if (!db.isOpen()) return 2;
+
+   QElapsedTimer timer;
+   timer.start();
+   InputChecker checker;
+   if (!checker.load(db)) {
+      std::cerr << args[0].toStdString() << " isn't a parsed database" << std::endl;
+      return 2;
+   }
+   std::cerr << checker.formNames().size() << " forms loaded from " << args[0].toStdString()
+             << " (" << timer.elapsed() << " ms)" << std::endl;
+
+   // unbuffered, so a read never waits on more than the client has sent
+   QFile in;
+   QFile out;
+   if (!in.open(stdin, QFile::ReadOnly | QFile::Unbuffered) || !out.open(stdout, QFile::WriteOnly)) return 2;
+   LanguageServer server(checker);
+   return server.run(in, out);
+}
+
+// --header <db> <out.h> [namespace]
+// writes the forms and slots as a constexpr C++ header (in namespace oeSqlCatalog by default)
+int Cli::header(const QStringList& args)
+{
+   if (args.size() != 2 && args.size() != 3) return usage();
+
+   QSqlDatabase db = openDatabase(args[0]);
+   if (!db.isOpen()) return 2;
+
+   QFile file(args[1]);
+   if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+      std::cerr << "unable to write " << args[1].toStdString() << std::endl;
+      return 2;
+   }
+   if (!CatalogHeader::write(db, &file, args.value(2, "oeSqlCatalog"))) {
+      std::cerr << "unable to generate the header from " << args[0].toStdString() << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+// --accepts <db> <class or form name>
+// lists every slot the class can be given to (as itself, or as one of its base classes)
+int Cli::accepts(const QStringList& args)
+{
+   if (args.size() != 2) return usage();
+
+   QSqlDatabase db = openDatabase(args[0]);
+   if (!db.isOpen()) return 2;
+   if (!ClassHierarchy::exists(db)) {
+      std::cerr << args[0].toStdString() << " has no class hierarchy; reparse it, or open it in the browser" << std::endl;
+      return 2;
+   }
+
+   QElapsedTimer timer;
+   timer.start();
+   const QList<ClassHierarchy::Acceptor> found = ClassHierarchy::acceptors(db, args[1]);
+   const qint64 elapsed = timer.nsecsElapsed() / 1000;
+
+   QTextStream out(stdout);
+   for (int i = 0; i < found.size(); i++) {
+      out << found[i].owner << "." << found[i].slot << " (" << found[i].type;
+      if (found[i].depth > 0) out << ", " << found[i].depth << " up";
+      out << ")\n";
+   }
+   out.flush();
+   std::cerr << found.size() << " slots (" << elapsed << " us)" << std::endl;
+   return 0;
+}
+
+// --bench-keywords <sourceDir>
+// times finding the parser's keywords in every line of the tree's .h and .cpp files, with a
+// contains() per keyword (as the parser used to) against the single pass KeywordMatcher
+int Cli::benchKeywords(const QStringList& args)
+{
+   if (args.size() != 1) return usage();
+
+   QStringList lines;
+   QDirIterator it(args[0], QStringList() << "*.h" << "*.cpp", QDir::Files, QDirIterator::Subdirectories);
+   while (it.hasNext()) {
+      QFile file(it.next());
+      if (!file.open(QFile::ReadOnly)) continue;
+      QTextStream stream(&file);
+      while (!stream.atEnd()) lines << stream.readLine();
+   }
+   if (lines.isEmpty()) {
+      std::cerr << "no .h or .cpp files under " << args[0].toStdString() << std::endl;
+      return 2;
+   }
+
+   const QStringList keywords = Parser::keywordList();
+   const KeywordMatcher matcher(keywords);
+   const int REPEATS = 5;
+   QVector<quint32> expected(lines.size());
+   QVector<quint32> actual(lines.size());
+
+   QElapsedTimer timer;
+   timer.start();
+   for (int r = 0; r < REPEATS; r++) {
+      for (int i = 0; i < lines.size(); i++) {
+         quint32 mask = 0;
+         for (int k = 0; k < keywords.size(); k++) {
+            if (lines[i].contains(keywords[k])) mask |= (1u << k);
+         }
+         expected[i] = mask;
+      }
+   }
+   const qint64 containsTime = timer.nsecsElapsed() / REPEATS;
+
+   timer.restart();
+   for (int r = 0; r < REPEATS; r++) {
+      for (int i = 0; i < lines.size(); i++) actual[i] = matcher.scan(lines[i]);
+   }
+   const qint64 matcherTime = timer.nsecsElapsed() / REPEATS;
+
+   int mismatches = 0;
+   for (int i = 0; i < lines.size(); i++) {
+      if (expected[i] != actual[i]) mismatches++;
+   }
+
+   QTextStream out(stdout);
+   out << lines.size() << " lines, " << keywords.size() << " keywords\n"
+       << "contains() per keyword: " << containsTime / 1000 << " us\n"
+       << "KeywordMatcher:         " << matcherTime / 1000 << " us ("
+       << QString::number(matcherTime ? double(containsTime) / matcherTime : 0.0, 'f', 1) << "x)\n";
+   if (mismatches > 0) out << mismatches << " lines matched differently!\n";
+   return (mismatches == 0 ? 0 : 1);
+}
@@ -0,0 +1,33 @@
+// headless commands, for scripts and other tools
+#ifndef CLI_H
+#define CLI_H
+
+#include <QSqlDatabase>
+#include <QStringList>
+
+// oeSql --<command> [arguments]
+// These run without a display (or any widgets), and return a process exit code.
+class Cli
+{
+public:
+   // true if the command line asks for a headless command
+   static bool isCommand(int argc, char* argv[]);
+   // runs the command (args[0]), returning the exit code
+   static int run(const QStringList& args);
+
+private:
+   static int parse(const QStringList& args);
+   static int diff(const QStringList& args);
+   static int lint(const QStringList& args);
+   static int header(const QStringList& args);
+   static int accepts(const QStringList& args);
+   static int benchKeywords(const QStringList& args);
+   static int exportData(const QStringList& args);
+   static int lsp(const QStringList& args);
+
+   static int usage();
+   // opens the database file read only, printing why if we can't
+   static QSqlDatabase openDatabase(const QString& fileName);
+};
+
+#endif // CLI_H
@@ -0,0 +1,264 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the demonstration applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "ConnectionWidget.h"
+#include "ConnectionPool.h"
+
+#include <QtWidgets>
+#include <QtSql>
+
+ConnectionWidget::ConnectionWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    tree = new QTreeWidget(this);
+    tree->setObjectName(QLatin1String("tree"));
+    tree->setHeaderLabels(QStringList() << tr("database") << tr("rows"));
+    tree->header()->setStretchLastSection(false);
+    tree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    tree->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    QAction *refreshAction = new QAction(tr("Refresh"), tree);
+//    metaDataAction = new QAction(tr("Show Schema"), tree);
+    connect(refreshAction, SIGNAL(triggered()), SLOT(refresh()));
+//    connect(metaDataAction, SIGNAL(triggered()), SLOT(showMetaData()));
+    tree->addAction(refreshAction);
+//    tree->addAction(metaDataAction);
+    tree->setContextMenuPolicy(Qt::ActionsContextMenu);
+
+    layout->addWidget(tree);
+
+    QMetaObject::connectSlotsByName(this);
+}
+
+ConnectionWidget::~ConnectionWidget()
+{
+}
+
+static QString qDBCaption(const QSqlDatabase &db)
+{
+//    QString nm = db.driverName();
+//    nm.append(QLatin1Char(':'));
+//    if (!db.userName().isEmpty())
+//        nm.append(db.userName()).append(QLatin1Char('@'));
+//    nm.append(db.databaseName());
+   QString temp = db.databaseName();
+   // we only want the file name!
+   int sIdx = temp.lastIndexOf("/") + 1;
+   temp = temp.right(temp.length() - sIdx);
+   return temp;
+}
+
+QStringList ConnectionWidget::databaseNames()
+{
+    QStringList names = QSqlDatabase::connectionNames();
+    for (int i = names.size() - 1; i >= 0; i--) {
+        if (ConnectionPool::isInternalConnection(names[i]))
+            names.removeAt(i);
+    }
+    return names;
+}
+
+// Only what changed is touched.  Each open database's metadata is cached against a cheap
+// fingerprint of the file, and is only (re)loaded, in the background, when that changes.
+void ConnectionWidget::refresh()
+{
+    const QStringList connectionNames = databaseNames();
+
+    // drop the databases that have gone away
+    for (int i = tree->topLevelItemCount() - 1; i >= 0; --i) {
+        const QString name = tree->topLevelItem(i)->data(0, Qt::UserRole).toString();
+        if (!connectionNames.contains(name)) {
+            delete tree->takeTopLevelItem(i);
+            infoCache.remove(name);
+        }
+    }
+
+    for (int i = 0; i < connectionNames.count(); ++i) {
+        const QString name = connectionNames.at(i);
+        QSqlDatabase db = QSqlDatabase::database(name, false);
+        QTreeWidgetItem *root = findItem(name);
+        if (!root) {
+            root = new QTreeWidgetItem(tree);
+            root->setText(0, qDBCaption(db));
+            root->setData(0, Qt::UserRole, name);
+        }
+        if (db.isOpen()) {
+            const QString fingerprint = DatabaseInfo::fingerprint(db);
+            const DatabaseInfo info = infoCache.value(name);
+            if (info.valid && info.stamp == fingerprint)
+                showInfo(root, info);
+            else if (!loading.contains(name))
+                loadInfo(name, fingerprint);
+        }
+        else {
+            qDeleteAll(root->takeChildren());
+        }
+    }
+
+    if (!connectionNames.contains(activeDb))
+        activeDb = connectionNames.value(0);
+    setActive(findItem(activeDb));
+
+    tree->doItemsLayout();
+}
+
+QTreeWidgetItem *ConnectionWidget::findItem(const QString &dbName) const
+{
+    for (int i = 0; i < tree->topLevelItemCount(); ++i) {
+        if (tree->topLevelItem(i)->data(0, Qt::UserRole).toString() == dbName)
+            return tree->topLevelItem(i);
+    }
+    return 0;
+}
+
+void ConnectionWidget::loadInfo(const QString &dbName, const QString &fingerprint)
+{
+    loading.insert(dbName);
+    QTreeWidgetItem *root = findItem(dbName);
+    if (root)
+        root->setText(1, tr("loading..."));
+
+    DatabaseInfoLoader *loader = new DatabaseInfoLoader(dbName, fingerprint);
+    connect(loader, SIGNAL(loaded(QString,DatabaseInfo)), SLOT(infoLoaded(QString,DatabaseInfo)));
+    QThreadPool::globalInstance()->start(loader);
+}
+
+void ConnectionWidget::infoLoaded(const QString &dbName, const DatabaseInfo &info)
+{
+    loading.remove(dbName);
+    QTreeWidgetItem *root = findItem(dbName);
+    // closed while we were loading
+    if (!root)
+        return;
+
+    infoCache.insert(dbName, info);
+    showInfo(root, info);
+
+    // and it may have changed again while we were loading
+    QSqlDatabase db = QSqlDatabase::database(dbName, false);
+    if (db.isOpen()) {
+        const QString fingerprint = DatabaseInfo::fingerprint(db);
+        if (fingerprint != info.stamp)
+            loadInfo(dbName, fingerprint);
+    }
+}
+
+// updates the database's table items in place, only adding, removing or changing what differs
+void ConnectionWidget::showInfo(QTreeWidgetItem *root, const DatabaseInfo &info)
+{
+    QHash<QString, QTreeWidgetItem*> oldTables;
+    for (int c = 0; c < root->childCount(); ++c)
+        oldTables.insert(root->child(c)->text(0), root->child(c));
+
+    for (int t = 0; t < info.tables.size(); ++t) {
+        QTreeWidgetItem *table = oldTables.take(info.tables[t].first);
+        if (!table) {
+            table = new QTreeWidgetItem(root);
+            table->setText(0, info.tables[t].first);
+        }
+        const QString rows = (info.tables[t].second < 0 ? QString() : QString::number(info.tables[t].second));
+        if (table->text(1) != rows)
+            table->setText(1, rows);
+    }
+    // whatever is left has gone away
+    qDeleteAll(oldTables);
+
+    root->setText(1, QString());
+    QString tip = tr("Schema version %1").arg(info.schemaVersion);
+    if (info.parseTime.isValid())
+        tip.append(tr("\nParsed %1 from %2").arg(info.parseTime.toString(), info.sourceDir));
+    root->setToolTip(0, tip);
+}
+
+QSqlDatabase ConnectionWidget::currentDatabase() const
+{
+    return ConnectionPool::instance().writer(activeDb);
+}
+
+static void qSetBold(QTreeWidgetItem *item, bool bold)
+{
+    QFont font = item->font(0);
+    font.setBold(bold);
+    item->setFont(0, font);
+}
+
+void ConnectionWidget::setActive(QTreeWidgetItem *item)
+{
+    for (int i = 0; i < tree->topLevelItemCount(); ++i) {
+        if (tree->topLevelItem(i)->font(0).bold())
+            qSetBold(tree->topLevelItem(i), false);
+    }
+
+    if (!item)
+        return;
+
+    qSetBold(item, true);
+    activeDb = item->data(0, Qt::UserRole).toString();
+}
+
+void ConnectionWidget::on_tree_itemActivated(QTreeWidgetItem *item, int /* column */)
+{
+
+    if (!item)
+        return;
+
+    if (!item->parent()) {
+        setActive(item);
+    } else {
+        setActive(item->parent());
+        emit tableActivated(item->text(0));
+    }
+}
+
+//void ConnectionWidget::showMetaData()
+//{
+//    QTreeWidgetItem *cItem = tree->currentItem();
+//    if (!cItem || !cItem->parent())
+//        return;
+//    setActive(cItem->parent());
+//    emit metaDataRequested(cItem->text(0));
+//}
+
+//void ConnectionWidget::on_tree_currentItemChanged(QTreeWidgetItem *current, QTreeWidgetItem *)
+//{
+//    metaDataAction->setEnabled(current && current->parent());
+//}
+
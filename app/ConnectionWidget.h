@@ -43,6 +43,10 @@
 #define CONNECTIONWIDGET_H
 
 #include <QWidget>
+#include <QHash>
+#include <QSet>
+
+#include "DatabaseInfo.h"
 
 QT_FORWARD_DECLARE_CLASS(QTreeWidget)
 QT_FORWARD_DECLARE_CLASS(QTreeWidgetItem)
@@ -59,6 +63,9 @@ public:
     QSqlDatabase currentDatabase() const;
     const QString currDatabaseName() const;
 
+    // names of the user's database connections (excluding our own internal connections)
+    static QStringList databaseNames();
+
 signals:
     void tableActivated(const QString &table);
     void metaDataRequested(const QString &tableName);
@@ -69,12 +76,20 @@ public slots:
     void on_tree_itemActivated(QTreeWidgetItem *item, int column);
     //void on_tree_currentItemChanged(QTreeWidgetItem *current, QTreeWidgetItem *previous);
 
+private slots:
+    void infoLoaded(const QString &dbName, const DatabaseInfo &info);
+
 private:
     void setActive(QTreeWidgetItem *);
+    QTreeWidgetItem *findItem(const QString &dbName) const;
+    void loadInfo(const QString &dbName, const QString &fingerprint);
+    void showInfo(QTreeWidgetItem *root, const DatabaseInfo &info);
 
     QTreeWidget* tree;
     //QAction* metaDataAction;
     QString activeDb;
+    QHash<QString, DatabaseInfo> infoCache;    // metadata of each database we've loaded
+    QSet<QString> loading;                     // databases we are loading metadata for
 };
 
 inline const QString ConnectionWidget::currDatabaseName() const      { return activeDb; }
@@ -0,0 +1,236 @@
+#include "HierarchyView.h"
+#include "ConnectionPool.h"
+#include "ClassHierarchy.h"
+
+#include <QHash>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QSqlQuery>
+#include <QStyleOptionGraphicsItem>
+#include <QVariant>
+#include <QWheelEvent>
+
+#include <cmath>
+
+HierarchyLoader::HierarchyLoader(const QString& name)
+   : dbName(name)
+{
+   qRegisterMetaType<HierarchyLayout>("HierarchyLayout");
+
+   // we delete ourselves (on the gui thread) when finished
+   setAutoDelete(false);
+}
+
+void HierarchyLoader::run()
+{
+   HierarchyLayout layout;
+   {
+      QSqlDatabase db = ConnectionPool::instance().reader(dbName);
+      QSqlQuery query(db);
+      query.setForwardOnly(true);
+      // sorted by name, so siblings are too
+      if (db.isOpen() && query.exec("SELECT id, className, baseClass FROM class ORDER BY className")) {
+         QVector<Class> classes;
+         QVector<QVariant> bases;
+         QHash<qint64, int> index;     // class.id -> classes index
+         while (query.next()) {
+            index.insert(query.value(0).toLongLong(), classes.size());
+            Class c;
+            c.name = query.value(1).toString();
+            classes << c;
+            bases << query.value(2);
+         }
+         QVector<int> roots;
+         for (int i = 0; i < classes.size(); i++) {
+            const int base = (bases[i].isNull() ? -1 : index.value(bases[i].toLongLong(), -1));
+            if (base >= 0 && base != i) classes[base].children << i;
+            else roots << i;
+         }
+
+         QVector<bool> placed(classes.size(), false);
+         int row = 0;
+         for (int i = 0; i < roots.size(); i++) place(classes, roots[i], -1, layout, placed, row, 0);
+         // anything left is in a baseClass loop; start it as a root of its own
+         for (int i = 0; i < classes.size(); i++) {
+            if (!placed[i]) place(classes, i, -1, layout, placed, row, 0);
+         }
+      }
+   }
+   emit loaded(layout);
+   deleteLater();
+}
+
+// adds the class, then its subtree, going down a row for each leaf
+void HierarchyLoader::place(const QVector<Class>& classes, const int index, const int parent, HierarchyLayout& layout,
+                            QVector<bool>& placed, int& row, const int depth) const
+{
+   placed[index] = true;
+   const int node = layout.nodes.size();
+   HierarchyLayout::Node n;
+   n.name = classes[index].name;
+   n.parent = parent;
+   n.descendants = 0;
+   layout.nodes << n;
+
+   int firstChild = -1;
+   int lastChild = -1;
+   const QVector<int>& children = classes[index].children;
+   for (int i = 0; i < children.size(); i++) {
+      if (placed[children[i]] || depth + 1 >= ClassHierarchy::MAX_DEPTH) continue;
+      const int child = layout.nodes.size();
+      place(classes, children[i], node, layout, placed, row, depth + 1);
+      if (firstChild < 0) firstChild = child;
+      lastChild = child;
+      layout.nodes[node].descendants += layout.nodes[child].descendants + 1;
+   }
+
+   HierarchyLayout::Node& me = layout.nodes[node];
+   qreal y;
+   if (firstChild < 0) {
+      y = row++ * HierarchyLayout::ROW_HEIGHT;
+      me.subtreeTop = y;
+      me.subtreeBottom = y + HierarchyLayout::NODE_HEIGHT;
+   }
+   else {
+      const HierarchyLayout::Node& first = layout.nodes[firstChild];
+      const HierarchyLayout::Node& last = layout.nodes[lastChild];
+      y = (first.pos.y() + last.pos.y()) / 2;
+      me.subtreeTop = first.subtreeTop;
+      me.subtreeBottom = last.subtreeBottom;
+   }
+   me.pos = QPointF(depth * HierarchyLayout::COLUMN_WIDTH, y);
+}
+
+ClassNodeItem::ClassNodeItem(const HierarchyLayout::Node& node, const QPointF& parentPos, QGraphicsItem* parent)
+   : QGraphicsItem(parent), name(node.name), numDescendants(node.descendants), collapsed(false)
+{
+   shortName = name.mid(name.lastIndexOf("::") + (name.contains("::") ? 2 : 0));
+   // child items are positioned relative to their parent
+   setPos(parent ? node.pos - parentPos : node.pos);
+   top = node.subtreeTop - node.pos.y();
+   bottom = node.subtreeBottom - node.pos.y();
+   if (parent) {
+      const qreal baseY = -pos().y() + HierarchyLayout::NODE_HEIGHT / 2;
+      edgeRect = QRectF(QPointF(-pos().x() + HierarchyLayout::NODE_WIDTH, qMin(baseY, qreal(0))),
+                        QPointF(0, qMax(baseY, qreal(HierarchyLayout::NODE_HEIGHT))));
+   }
+   setToolTip(name);
+}
+
+QRectF ClassNodeItem::boundingRect() const
+{
+   QRectF rect(0, 0, HierarchyLayout::NODE_WIDTH, HierarchyLayout::NODE_HEIGHT);
+   if (!edgeRect.isNull()) rect |= edgeRect;
+   if (collapsed) {
+      rect |= QRectF(HierarchyLayout::COLUMN_WIDTH, top, HierarchyLayout::NODE_WIDTH, bottom - top);
+   }
+   return rect;
+}
+
+void ClassNodeItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*)
+{
+   const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+   const qreal midY = HierarchyLayout::NODE_HEIGHT / 2;
+
+   // the edge back to our base class (a straight line when we're small)
+   if (!edgeRect.isNull()) {
+      painter->setPen(Qt::gray);
+      const QPointF from(edgeRect.left(), -pos().y() + midY);
+      const QPointF to(0, midY);
+      if (lod < 0.5) painter->drawLine(from, to);
+      else {
+         const qreal midX = (from.x() + to.x()) / 2;
+         const QPointF points[4] = { from, QPointF(midX, from.y()), QPointF(midX, to.y()), to };
+         painter->drawPolyline(points, 4);
+      }
+   }
+
+   const QRectF rect(0, 0, HierarchyLayout::NODE_WIDTH, HierarchyLayout::NODE_HEIGHT);
+   painter->setPen(lod < 0.25 ? QPen(Qt::NoPen) : QPen(Qt::darkGray));
+   painter->setBrush(option->state & QStyle::State_Selected ? QColor(255, 220, 140) : QColor(220, 232, 250));
+   painter->drawRect(rect);
+   if (lod >= 0.5) {
+      painter->setPen(Qt::black);
+      painter->drawText(rect.adjusted(4, 0, -4, 0), Qt::AlignLeft | Qt::AlignVCenter, shortName);
+   }
+
+   // the collapsed subtree, as one bar covering where it would be
+   if (collapsed) {
+      const QRectF bar(HierarchyLayout::COLUMN_WIDTH, top, HierarchyLayout::NODE_WIDTH, bottom - top);
+      painter->setPen(Qt::gray);
+      painter->drawLine(QPointF(HierarchyLayout::NODE_WIDTH, midY), QPointF(bar.left(), midY));
+      painter->setPen(Qt::NoPen);
+      painter->setBrush(QColor(200, 200, 200));
+      painter->drawRect(bar);
+      if (lod * bar.height() >= HierarchyLayout::NODE_HEIGHT / 2 && lod >= 0.25) {
+         painter->setPen(Qt::black);
+         painter->drawText(bar, Qt::AlignCenter, QObject::tr("%1 classes").arg(numDescendants));
+      }
+   }
+}
+
+void ClassNodeItem::setCollapsed(const bool collapse)
+{
+   if (collapse == collapsed) return;
+   prepareGeometryChange();
+   collapsed = collapse;
+   const QList<QGraphicsItem*> children = childItems();
+   for (int i = 0; i < children.size(); i++) children[i]->setVisible(!collapsed);
+}
+
+HierarchyView::HierarchyView(QWidget* parent)
+   : QGraphicsView(parent)
+{
+   QGraphicsScene* scene = new QGraphicsScene(this);
+   // the default, but it is what makes finding the visible nodes cheap
+   scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+   setScene(scene);
+   setDragMode(QGraphicsView::ScrollHandDrag);
+   setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+   setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+   setOptimizationFlags(QGraphicsView::DontSavePainterState | QGraphicsView::DontAdjustForAntialiasing);
+}
+
+void HierarchyView::setHierarchy(const HierarchyLayout& layout)
+{
+   scene()->clear();
+   items.clear();
+   items.reserve(layout.nodes.size());
+   for (int i = 0; i < layout.nodes.size(); i++) {
+      const HierarchyLayout::Node& node = layout.nodes[i];
+      const int parent = node.parent;
+      ClassNodeItem* item = new ClassNodeItem(node, (parent >= 0 ? layout.nodes[parent].pos : QPointF()),
+                                              (parent >= 0 ? items[parent] : 0));
+      item->setFlag(QGraphicsItem::ItemIsSelectable);
+      if (parent < 0) scene()->addItem(item);
+      items << item;
+   }
+   scene()->setSceneRect(scene()->itemsBoundingRect());
+   updateCollapsed();
+}
+
+void HierarchyView::wheelEvent(QWheelEvent* event)
+{
+   const qreal factor = std::pow(1.15, event->angleDelta().y() / 120.0);
+   const qreal zoom = transform().m11() * factor;
+   if (zoom < 0.005 || zoom > 4) return;
+   scale(factor, factor);
+   updateCollapsed();
+}
+
+void HierarchyView::mouseDoubleClickEvent(QMouseEvent* event)
+{
+   ClassNodeItem* item = qgraphicsitem_cast<ClassNodeItem*>(itemAt(event->pos()));
+   if (item) emit classActivated(item->className());
+   else QGraphicsView::mouseDoubleClickEvent(event);
+}
+
+void HierarchyView::updateCollapsed()
+{
+   const qreal zoom = transform().m22();
+   const bool small = (HierarchyLayout::ROW_HEIGHT * zoom < MIN_ROW_PIXELS);
+   for (int i = 0; i < items.size(); i++) {
+      ClassNodeItem* item = items[i];
+      item->setCollapsed(small && item->descendants() > 0 && item->subtreeHeight() * zoom < COLLAPSE_PIXELS);
+   }
+}
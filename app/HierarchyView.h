@@ -0,0 +1,120 @@
+// the class inheritance tree, drawn as a graph
+#ifndef HIERARCHYVIEW_H
+#define HIERARCHYVIEW_H
+
+#include <QGraphicsItem>
+#include <QGraphicsView>
+#include <QMetaType>
+#include <QObject>
+#include <QRunnable>
+#include <QSqlDatabase>
+#include <QVector>
+
+// Where each class goes: depth (from its root class) across, and one row per leaf down, with each
+// base class centered on the classes derived from it.  Parents come before their children.
+struct HierarchyLayout {
+   struct Node {
+      QString name;        // qualified class name
+      int parent;          // node index, or -1 for a root
+      QPointF pos;         // top left of the node
+      qreal subtreeTop;    // extent (y) of the node and everything derived from it
+      qreal subtreeBottom;
+      int descendants;
+   };
+   QVector<Node> nodes;
+
+   static const int NODE_WIDTH = 180;
+   static const int NODE_HEIGHT = 20;
+   static const int COLUMN_WIDTH = 240;
+   static const int ROW_HEIGHT = 26;
+};
+
+Q_DECLARE_METATYPE(HierarchyLayout)
+
+// Reads the class table through a pooled read connection and lays it out on a QThreadPool thread,
+// then deletes itself.
+class HierarchyLoader : public QObject, public QRunnable
+{
+   Q_OBJECT
+public:
+   explicit HierarchyLoader(const QString& dbName);
+
+   virtual void run();
+
+signals:
+   void loaded(const HierarchyLayout& layout);
+
+private:
+   struct Class {
+      QString name;
+      QVector<int> children;
+   };
+   void place(const QVector<Class>& classes, const int index, const int parent, HierarchyLayout& layout,
+              QVector<bool>& placed, int& row, const int depth) const;
+
+   QString dbName;
+};
+
+// One class.  It draws the edge back to its base class too, and its children (the classes derived
+// from it) are its child items, so collapsing it hides the whole subtree in one go.
+class ClassNodeItem : public QGraphicsItem
+{
+public:
+   ClassNodeItem(const HierarchyLayout::Node& node, const QPointF& parentPos, QGraphicsItem* parent);
+
+   enum { Type = UserType + 1 };
+   virtual int type() const         { return Type; }
+
+   virtual QRectF boundingRect() const;
+   virtual void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget);
+
+   QString className() const        { return name; }
+   int descendants() const          { return numDescendants; }
+   qreal subtreeHeight() const      { return bottom - top; }
+
+   bool isCollapsed() const         { return collapsed; }
+   // hides (or shows) everything derived from us, drawing a summary in its place
+   void setCollapsed(const bool collapse);
+
+private:
+   QString name;
+   QString shortName;      // without the namespaces
+   int numDescendants;
+   qreal top;              // subtree extent, relative to us
+   qreal bottom;
+   QRectF edgeRect;        // from our base class to us
+   bool collapsed;
+};
+
+// Zooming out (past where the names can be read) collapses any subtree that would be only a few
+// pixels high into a single summary bar, so the scene only ever draws about a screenful of nodes,
+// whatever the size of the hierarchy.  The scene's BSP index keeps finding those nodes cheap.
+// Double clicking a class activates it.
+class HierarchyView : public QGraphicsView
+{
+   Q_OBJECT
+public:
+   explicit HierarchyView(QWidget* parent = 0);
+
+public slots:
+   void setHierarchy(const HierarchyLayout& layout);
+
+signals:
+   void classActivated(const QString& className);
+
+protected:
+   virtual void wheelEvent(QWheelEvent* event);
+   virtual void mouseDoubleClickEvent(QMouseEvent* event);
+
+private:
+   // collapses the subtrees too small to see at the current zoom (and expands the rest)
+   void updateCollapsed();
+
+   QVector<ClassNodeItem*> items;      // parents before children
+
+   // once rows are smaller than this (on screen), subtrees shorter than COLLAPSE_PIXELS are collapsed
+   static const int MIN_ROW_PIXELS = 8;
+   static const int COLLAPSE_PIXELS = 24;
+};
+
+#endif // HIERARCHYVIEW_H
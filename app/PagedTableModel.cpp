@@ -0,0 +1,280 @@
+#include "PagedTableModel.h"
+
+#include <QSet>
+#include <QSqlDriver>
+#include <QSqlField>
+#include <QSqlQuery>
+#include <QSqlRecord>
+
+PagedTableModel::PagedTableModel(QObject* parent, QSqlDatabase database)
+   : QAbstractTableModel(parent), db(database), sortColumn(-1), sortOrder(Qt::AscendingOrder), numRows(0)
+{
+   pages.setMaxCost(MAX_PAGES);
+}
+
+PagedTableModel::~PagedTableModel()
+{
+}
+
+void PagedTableModel::setTable(const QString& tableName)
+{
+   beginResetModel();
+   table = tableName;
+   columns.clear();
+   relations.clear();
+   headers.clear();
+   QSqlRecord record = db.record(tableName);
+   for (int i = 0; i < record.count(); i++) {
+      columns << db.driver()->escapeIdentifier(record.fieldName(i), QSqlDriver::FieldName);
+   }
+   sortColumn = -1;
+   sortOrder = Qt::AscendingOrder;
+   pageStarts.clear();
+   numRows = 0;
+   pages.clear();
+   endResetModel();
+}
+
+void PagedTableModel::setRelation(const int column, const QString& relTable, const QString& keyColumn, const QString& displayColumn)
+{
+   Relation relation;
+   relation.table = relTable;
+   relation.keyColumn = keyColumn;
+   relation.displayColumn = displayColumn;
+   relations.insert(column, relation);
+}
+
+bool PagedTableModel::select()
+{
+   beginResetModel();
+   pageStarts.clear();
+   numRows = 0;
+   pages.clear();
+   error = QSqlError();
+
+   // no sorting here, the pages find their own starts as they are shown
+   QSqlQuery query(db);
+   query.setForwardOnly(true);
+   if (query.exec(QString("SELECT COUNT(*) FROM %1").arg(table)) && query.next()) numRows = query.value(0).toInt();
+   else error = query.lastError();
+
+   endResetModel();
+   return (error.type() == QSqlError::NoError);
+}
+
+int PagedTableModel::findRow(const qint64 rowid) const
+{
+   QSqlQuery query(db);
+   query.setForwardOnly(true);
+   query.prepare(QString("SELECT %1 FROM %2 WHERE rowid = ?").arg(sortValue(), table));
+   query.addBindValue(rowid);
+   if (!query.exec() || !query.next()) return -1;
+
+   Key key;
+   key.value = query.value(0);
+   key.rowid = rowid;
+   QVariantList binds;
+   query.prepare(QString("SELECT COUNT(*) FROM %1 WHERE %2").arg(table, atOrAfter(key, binds)));
+   for (int i = 0; i < binds.size(); i++) query.addBindValue(binds[i]);
+   if (!query.exec() || !query.next()) return -1;
+
+   // everything that isn't at or after us, is before us
+   return numRows - query.value(0).toInt();
+}
+
+int PagedTableModel::rowCount(const QModelIndex& parent) const
+{
+   return (parent.isValid() ? 0 : numRows);
+}
+
+int PagedTableModel::columnCount(const QModelIndex& parent) const
+{
+   return (parent.isValid() ? 0 : columns.size());
+}
+
+QVariant PagedTableModel::data(const QModelIndex& index, int role) const
+{
+   if (!index.isValid() || role != Qt::DisplayRole) return QVariant();
+
+   const Page* rows = page(index.row() / PAGE_SIZE);
+   const int row = index.row() % PAGE_SIZE;
+   if (rows == 0 || row >= rows->size()) return QVariant();
+   return rows->at(row).value(index.column());
+}
+
+QVariant PagedTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+   if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+      if (headers.contains(section)) return headers.value(section);
+      QString name = columns.value(section);
+      return db.driver()->stripDelimiters(name, QSqlDriver::FieldName);
+   }
+   return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+bool PagedTableModel::setHeaderData(int section, Qt::Orientation orientation, const QVariant& value, int role)
+{
+   if (orientation != Qt::Horizontal || (role != Qt::EditRole && role != Qt::DisplayRole)) return false;
+   headers.insert(section, value);
+   emit headerDataChanged(orientation, section, section);
+   return true;
+}
+
+// sorting by a relation column sorts by its id, as the display values live in another table
+void PagedTableModel::sort(int column, Qt::SortOrder order)
+{
+   sortColumn = (column >= 0 && column < columns.size() ? column : -1);
+   sortOrder = order;
+   select();
+}
+
+const PagedTableModel::Page* PagedTableModel::page(const int pageNum) const
+{
+   Page* rows = pages.object(pageNum);
+   if (rows != 0 || pageNum * PAGE_SIZE >= numRows) return rows;
+
+   QVariantList binds;
+   QString where;
+   if (pageNum > 0) {
+      Key start;
+      if (!pageStart(pageNum, start)) return 0;
+      where = "WHERE " + atOrAfter(start, binds);
+   }
+   // one row more than the page, which is where the next page starts
+   QSqlQuery query(db);
+   query.setForwardOnly(true);
+   query.prepare(QString("SELECT %1, %2, rowid FROM %3 %4 ORDER BY %5 LIMIT %6")
+                 .arg(columns.join(", "), sortValue(), table, where, orderBy()).arg(PAGE_SIZE + 1));
+   for (int i = 0; i < binds.size(); i++) query.addBindValue(binds[i]);
+   if (!query.exec()) {
+      // nothing cached, so the page is tried again when next shown
+      error = query.lastError();
+      return 0;
+   }
+
+   rows = new Page;
+   rows->reserve(PAGE_SIZE);
+   while (query.next()) {
+      if (rows->size() == PAGE_SIZE) {
+         Key next;
+         next.value = query.value(columns.size());
+         next.rowid = query.value(columns.size() + 1).toLongLong();
+         pageStarts.insert(pageNum + 1, next);
+         break;
+      }
+      QVector<QVariant> row(columns.size());
+      for (int c = 0; c < columns.size(); c++) row[c] = query.value(c);
+      rows->append(row);
+   }
+   resolveRelations(*rows);
+   pages.insert(pageNum, rows);
+   return rows;
+}
+
+// The fallback for jumps: skips forward from the nearest page start before it that we know (if any)
+// with OFFSET, which still steps over every row in between, though only the sort column and rowid
+// (an index scan if the column is indexed, a scan and sort of the table if not).  Scrolling never
+// gets here, as each page hands the next its start.
+bool PagedTableModel::pageStart(const int pageNum, Key& key) const
+{
+   if (pageStarts.contains(pageNum)) {
+      key = pageStarts.value(pageNum);
+      return true;
+   }
+
+   int known = pageNum - 1;
+   while (known > 0 && !pageStarts.contains(known)) known--;
+   QVariantList binds;
+   const QString where = (known > 0 ? "WHERE " + atOrAfter(pageStarts.value(known), binds) : QString());
+   QSqlQuery query(db);
+   query.setForwardOnly(true);
+   query.prepare(QString("SELECT %1, rowid FROM %2 %3 ORDER BY %4 LIMIT 1 OFFSET %5")
+                 .arg(sortValue(), table, where, orderBy()).arg((pageNum - known) * PAGE_SIZE));
+   for (int i = 0; i < binds.size(); i++) query.addBindValue(binds[i]);
+   if (!query.exec()) {
+      error = query.lastError();
+      return false;
+   }
+   if (!query.next()) return false;
+
+   key.value = query.value(0);
+   key.rowid = query.value(1).toLongLong();
+   pageStarts.insert(pageNum, key);
+   return true;
+}
+
+// swaps the ids in the relation columns for their display values, looking up (in one query per
+// relation) only the ids we haven't seen yet
+void PagedTableModel::resolveRelations(Page& rows) const
+{
+   QHash<int, Relation>::iterator it;
+   for (it = relations.begin(); it != relations.end(); ++it) {
+      const int column = it.key();
+      Relation& relation = it.value();
+      if (relation.cache.size() > MAX_CACHED_NAMES) relation.cache.clear();
+
+      QVariantList missing;
+      QSet<qint64> seen;
+      for (int r = 0; r < rows.size(); r++) {
+         const QVariant id = rows[r].value(column);
+         if (id.isNull()) continue;
+         const qint64 key = id.toLongLong();
+         if (!relation.cache.contains(key) && !seen.contains(key)) {
+            seen.insert(key);
+            missing << id;
+         }
+      }
+      if (!missing.isEmpty()) {
+         QString placeholders = "?";
+         for (int i = 1; i < missing.size(); i++) placeholders.append(", ?");
+         QSqlQuery query(db);
+         query.setForwardOnly(true);
+         query.prepare(QString("SELECT %1, %2 FROM %3 WHERE %1 IN (%4)")
+                       .arg(relation.keyColumn, relation.displayColumn, relation.table, placeholders));
+         for (int i = 0; i < missing.size(); i++) query.addBindValue(missing[i]);
+         query.exec();
+         while (query.next()) {
+            relation.cache.insert(query.value(0).toLongLong(), query.value(1));
+         }
+      }
+
+      // anything without a match shows up empty, as it would with a left join
+      for (int r = 0; r < rows.size(); r++) {
+         const QVariant id = rows[r].value(column);
+         rows[r][column] = (id.isNull() ? QVariant() : relation.cache.value(id.toLongLong()));
+      }
+   }
+}
+
+QString PagedTableModel::orderBy() const
+{
+   const QString dir = (sortOrder == Qt::AscendingOrder ? "ASC" : "DESC");
+   if (sortColumn < 0) return "rowid " + dir;
+   return QString("%1 %2, rowid %2").arg(columns[sortColumn], dir);
+}
+
+QString PagedTableModel::sortValue() const
+{
+   return (sortColumn >= 0 ? columns[sortColumn] : QString("NULL"));
+}
+
+QString PagedTableModel::atOrAfter(const Key& key, QVariantList& binds) const
+{
+   const bool ascending = (sortOrder == Qt::AscendingOrder);
+   const QString rowidCheck = (ascending ? "rowid >= ?" : "rowid <= ?");
+   if (sortColumn < 0) {
+      binds << key.rowid;
+      return rowidCheck;
+   }
+
+   // sqlite puts NULLs first going up, and last going down
+   const QString column = columns[sortColumn];
+   if (key.value.isNull()) {
+      binds << key.rowid;
+      if (ascending) return QString("((%1 IS NULL AND %2) OR %1 IS NOT NULL)").arg(column, rowidCheck);
+      return QString("(%1 IS NULL AND %2)").arg(column, rowidCheck);
+   }
+   binds << key.value << key.value << key.rowid;
+   if (ascending) return QString("(%1 > ? OR (%1 = ? AND %2))").arg(column, rowidCheck);
+   return QString("(%1 < ? OR (%1 = ? AND %2) OR %1 IS NULL)").arg(column, rowidCheck);
+}
@@ -0,0 +1,92 @@
+// read only table model that pages through large tables
+#ifndef PAGEDTABLEMODEL_H
+#define PAGEDTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QCache>
+#include <QHash>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QStringList>
+#include <QVector>
+
+// QSqlRelationalTableModel joins and loads the whole table, which stalls on tables like slotTable and
+// slotObjTable.  This model only keeps a few pages of rows, fetched with keyset pagination
+// (WHERE (sort column, rowid) >= page start ... LIMIT n).  Selecting (or sorting) just counts the rows;
+// each page's start is found lazily, from the end of the page before it when scrolling.  Jumping
+// ahead falls back to an OFFSET over the sort column and rowid from the nearest start we know, so it
+// costs the rows jumped over.  Sorting is only cheap on indexed columns (the parser indexes the id
+// columns of the slot tables); any other column is sorted for every page.  Relation columns are
+// resolved a page at a time, through a cache of id -> display values.
+class PagedTableModel : public QAbstractTableModel
+{
+   Q_OBJECT
+public:
+   explicit PagedTableModel(QObject* parent = 0, QSqlDatabase db = QSqlDatabase());
+   virtual ~PagedTableModel();
+
+   // the (escaped) table we show
+   void setTable(const QString& tableName);
+   // show the related table's display column, rather than the id, in the given column
+   void setRelation(const int column, const QString& relTable, const QString& keyColumn, const QString& displayColumn);
+   // (re)counts the rows, returns false on error
+   bool select();
+   QSqlError lastError() const;
+
+   // row of the record with the given rowid, or -1 if there isn't one
+   int findRow(const qint64 rowid) const;
+
+   int rowCount(const QModelIndex& parent = QModelIndex()) const;
+   int columnCount(const QModelIndex& parent = QModelIndex()) const;
+   QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+   QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+   bool setHeaderData(int section, Qt::Orientation orientation, const QVariant& value, int role = Qt::EditRole);
+   void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
+
+   static const int PAGE_SIZE = 256;            // rows per page
+   static const int MAX_PAGES = 16;             // pages we keep around
+   static const int MAX_CACHED_NAMES = 65536;   // relation display values we keep around
+
+private:
+   // where a page starts, in sort order
+   struct Key {
+      QVariant value;   // sort column value (unused when sorting by rowid)
+      qint64 rowid;
+   };
+
+   struct Relation {
+      QString table;
+      QString keyColumn;
+      QString displayColumn;
+      QHash<qint64, QVariant> cache;   // id -> display value
+   };
+
+   typedef QVector< QVector<QVariant> > Page;
+
+   const Page* page(const int pageNum) const;
+   // finds (and remembers) where the page starts, false if it doesn't
+   bool pageStart(const int pageNum, Key& key) const;
+   void resolveRelations(Page& rows) const;
+   QString orderBy() const;
+   // the sort column (NULL when sorting by rowid)
+   QString sortValue() const;
+   // condition for the rows at or after the key in sort order, adding its bind values
+   QString atOrAfter(const Key& key, QVariantList& binds) const;
+
+   QSqlDatabase db;
+   QString table;
+   QStringList columns;             // escaped column names
+   QHash<int, QVariant> headers;
+   mutable QHash<int, Relation> relations;
+   int sortColumn;                  // -1 for rowid order
+   Qt::SortOrder sortOrder;
+
+   mutable QHash<int, Key> pageStarts; // first row of the pages we know (page 0 starts at the start)
+   int numRows;
+   mutable QCache<int, Page> pages;
+   mutable QSqlError error;
+};
+
+inline QSqlError PagedTableModel::lastError() const       { return error; }
+
+#endif // PAGEDTABLEMODEL_H
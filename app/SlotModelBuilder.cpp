@@ -0,0 +1,121 @@
+#include "SlotModelBuilder.h"
+#include "NameTable.h"
+#include "ClassHierarchy.h"
+#include "ConnectionPool.h"
+
+#include <QSqlQuery>
+#include <QHash>
+#include <QVector>
+
+// number of classes we hand to the model at a time
+static const int BATCH_SIZE = 128;
+
+SlotModelBuilder::SlotModelBuilder(const QString& name, TreeModel* model)
+   : dbName(name), canceled(0)
+{
+   qRegisterMetaType< QList<TreeModel::Class> >("QList<TreeModel::Class>");
+
+   // we delete ourselves (on the gui thread) when finished
+   setAutoDelete(false);
+
+   connect(this, SIGNAL(classesReady(QList<TreeModel::Class>)), model, SLOT(addClasses(QList<TreeModel::Class>)), Qt::QueuedConnection);
+   connect(model, SIGNAL(destroyed()), this, SLOT(cancel()), Qt::DirectConnection);
+}
+
+void SlotModelBuilder::cancel()
+{
+   canceled.storeRelease(1);
+}
+
+void SlotModelBuilder::run()
+{
+   // Qt connections can't cross threads, so read through our thread's own
+   int numClasses = 0;
+   QSqlDatabase db = ConnectionPool::instance().reader(dbName);
+   if (db.isOpen()) numClasses = build(db);
+
+   emit finished(dbName, numClasses);
+   deleteLater();
+}
+
+// The tree is loaded with a fixed number of set based queries, streamed forward only, rather than a
+// query per class, per slot and per slot object.  The slots (own and inherited) are joined onto the
+// classes in name order (through classNameIdx, then classAncestorIdx and slotParentIdx, so sqlite
+// needn't sort anything), so each class is complete as soon as the next one starts, and each batch
+// is sent off as soon as it is full.
+int SlotModelBuilder::build(QSqlDatabase db)
+{
+   NameTable& names = NameTable::instance();
+
+   QSqlQuery query(db);
+   query.setForwardOnly(true);
+
+   // class id -> interned class name
+   QHash<qint64, int> classNames;
+   query.exec("SELECT id, className FROM class");
+   while (query.next()) {
+      QString className = query.value(1).toString();
+      if (!className.isEmpty()) classNames.insert(query.value(0).toLongLong(), names.intern(className));
+   }
+
+   // slot id -> accepted object types
+   QHash<qint64, QVector<int> > slotTypes;
+   query.exec("SELECT slotId, objId FROM slotObjTable");
+   while (query.next()) {
+      QHash<qint64, int>::const_iterator it = classNames.constFind(query.value(1).toLongLong());
+      if (it != classNames.constEnd()) slotTypes[query.value(0).toLongLong()] << it.value();
+   }
+
+   // now walk the classes and their slots together, including the inherited slots when the
+   // database has them (own slots first, then each base class's going up).  This is the
+   // effectiveSlot view, spelled out so the classes without slots come through too.
+   if (ClassHierarchy::exists(db)) {
+      query.exec("SELECT class.id, slotTable.slotName, slotTable.slotId, classAncestor.ancestorId, classAncestor.depth FROM class "
+                 "LEFT JOIN classAncestor ON classAncestor.classId = class.id "
+                 "LEFT JOIN slotTable ON slotTable.parentId = classAncestor.ancestorId "
+                 "ORDER BY class.className, class.rowid, classAncestor.depth, classAncestor.rowid, slotTable.slotIndex");
+   }
+   else {
+      query.exec("SELECT class.id, slotTable.slotName, slotTable.slotId, NULL, 0 FROM class "
+                 "LEFT JOIN slotTable ON slotTable.parentId = class.id "
+                 "ORDER BY class.className, class.rowid, slotTable.slotIndex");
+   }
+
+   int numClasses = 0;
+   QList<TreeModel::Class> batch;
+   TreeModel::Class cls;
+   qint64 classId = -1;
+   while (query.next() && !canceled.loadAcquire()) {
+      if (query.value(0).toLongLong() != classId) {
+         if (classId >= 0) {
+            batch << cls;
+            if (batch.size() == BATCH_SIZE) {
+               emit classesReady(batch);
+               batch.clear();
+            }
+         }
+         classId = -1;
+         // skip the classes we don't show
+         QHash<qint64, int>::const_iterator it = classNames.constFind(query.value(0).toLongLong());
+         if (it == classNames.constEnd()) continue;
+         classId = it.key();
+         cls = TreeModel::Class();
+         cls.name = it.value();
+         numClasses++;
+      }
+      QString slotName = query.value(1).toString();
+      if (!slotName.isEmpty()) {
+         TreeModel::Slot slot;
+         slot.name = names.intern(slotName);
+         slot.types = slotTypes.value(query.value(2).toLongLong());
+         if (query.value(4).toInt() > 0) slot.inheritedFrom = classNames.value(query.value(3).toLongLong(), -1);
+         cls.slotList << slot;
+      }
+   }
+   if (canceled.loadAcquire()) return numClasses;
+
+   if (classId >= 0) batch << cls;
+   if (!batch.isEmpty()) emit classesReady(batch);
+
+   return numClasses;
+}
@@ -0,0 +1,38 @@
+// builds a class/slot tree model for one database on a worker thread
+#ifndef SLOTMODELBUILDER_H
+#define SLOTMODELBUILDER_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QAtomicInt>
+#include <QSqlDatabase>
+
+#include "TreeModel.h"
+
+// Loads the class -> slot -> slot type tree of a database, through a pooled read connection, so it
+// can run on a QThreadPool thread.  Classes are handed to the model in batches (through a queued
+// connection) as they are read, so the view fills in while the rest is still loading.  The
+// builder deletes itself once it is done, and stops early if the model goes away.
+class SlotModelBuilder : public QObject, public QRunnable
+{
+   Q_OBJECT
+public:
+   SlotModelBuilder(const QString& dbName, TreeModel* model);
+
+   virtual void run();
+
+public slots:
+   void cancel();
+
+signals:
+   void classesReady(const QList<TreeModel::Class>& classes);
+   void finished(const QString& dbName, const int numClasses);
+
+private:
+   int build(QSqlDatabase db);
+
+   QString dbName;         // database (file) name we are loading
+   QAtomicInt canceled;
+};
+
+#endif // SLOTMODELBUILDER_H
@@ -0,0 +1,181 @@
+#include "SqlConsole.h"
+
+#include <QtWidgets>
+#include <QtSql>
+
+SqlConsole::SqlConsole(QWidget* parent)
+   : QWidget(parent)
+{
+   sqlEdit = new QPlainTextEdit(this);
+   sqlEdit->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+   sqlEdit->setPlaceholderText(tr("SQL to run against the selected database (Ctrl+Return)"));
+
+   QPushButton* runButton = new QPushButton(tr("&Run"), this);
+   QPushButton* explainButton = new QPushButton(tr("E&xplain"), this);
+   connect(runButton, SIGNAL(clicked()), this, SLOT(run()));
+   connect(explainButton, SIGNAL(clicked()), this, SLOT(explain()));
+   QShortcut* shortcut = new QShortcut(QKeySequence(Qt::CTRL + Qt::Key_Return), sqlEdit);
+   shortcut->setContext(Qt::WidgetShortcut);
+   connect(shortcut, SIGNAL(activated()), this, SLOT(run()));
+
+   status = new QLabel(this);
+   status->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+   model = new QSqlQueryModel(this);
+   connect(model, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(rowsFetched()));
+   results = new QTableView(this);
+   results->setModel(model);
+   results->verticalHeader()->setDefaultSectionSize(results->fontMetrics().height() + 4);
+
+   plan = new QTreeWidget(this);
+   plan->setHeaderLabels(QStringList() << tr("query plan") << tr("table rows"));
+   plan->setUniformRowHeights(true);
+
+   QSplitter* output = new QSplitter(Qt::Horizontal, this);
+   output->addWidget(results);
+   output->addWidget(plan);
+   output->setStretchFactor(0, 2);
+   output->setStretchFactor(1, 1);
+
+   QHBoxLayout* buttons = new QHBoxLayout;
+   buttons->addWidget(status, 1);
+   buttons->addWidget(explainButton);
+   buttons->addWidget(runButton);
+
+   QSplitter* splitter = new QSplitter(Qt::Vertical, this);
+   splitter->addWidget(sqlEdit);
+   QWidget* bottom = new QWidget(splitter);
+   QVBoxLayout* bottomLayout = new QVBoxLayout(bottom);
+   bottomLayout->setContentsMargins(0, 0, 0, 0);
+   bottomLayout->addLayout(buttons);
+   bottomLayout->addWidget(output);
+   splitter->addWidget(bottom);
+   splitter->setStretchFactor(1, 3);
+
+   QVBoxLayout* layout = new QVBoxLayout(this);
+   layout->setContentsMargins(0, 0, 0, 0);
+   layout->addWidget(splitter);
+}
+
+void SqlConsole::run()
+{
+   emit runRequested(sqlEdit->toPlainText(), false);
+}
+
+void SqlConsole::explain()
+{
+   emit runRequested(sqlEdit->toPlainText(), true);
+}
+
+void SqlConsole::clear()
+{
+   model->clear();
+   plan->clear();
+   status->clear();
+}
+
+void SqlConsole::exec(QSqlDatabase db, const QString& text, const bool explainOnly)
+{
+   clear();
+   const QString sql = text.trimmed();
+   if (sql.isEmpty()) return;
+   if (!db.isOpen()) {
+      status->setText(tr("No database selected"));
+      return;
+   }
+
+   const QStringList scans = showPlan(db, sql, !explainOnly);
+   const QString scanned = (scans.isEmpty() ? QString() : tr(", full scans of %1").arg(scans.join(", ")));
+   if (explainOnly) {
+      status->setText(tr("Explained%1").arg(scanned));
+      return;
+   }
+
+   QApplication::setOverrideCursor(Qt::WaitCursor);
+   QElapsedTimer timer;
+   timer.start();
+   QSqlQuery query(db);
+   const bool ok = query.exec(sql);
+   const qint64 execTime = timer.elapsed();
+   if (ok && query.isSelect()) {
+      // hands the statement over, and fetches the first block of rows
+      model->setQuery(query);
+   }
+   const qint64 firstRows = timer.elapsed();
+   QApplication::restoreOverrideCursor();
+
+   if (!ok) {
+      status->setText(query.lastError().text());
+   }
+   else if (!query.isSelect()) {
+      status->setText(tr("%1 rows changed in %2 ms%3").arg(query.numRowsAffected()).arg(execTime).arg(scanned));
+   }
+   else {
+      timing = tr("%1 ms to run, %2 ms to the first rows%3").arg(execTime).arg(firstRows).arg(scanned);
+      rowsFetched();
+   }
+}
+
+// the model fetches a block of rows at a time as the view scrolls
+void SqlConsole::rowsFetched()
+{
+   if (timing.isEmpty() || !model->query().isSelect()) return;
+   const QString rows = (model->canFetchMore() ? tr("%1+ rows").arg(model->rowCount()) : tr("%1 rows").arg(model->rowCount()));
+   status->setText(rows + " (" + timing + ")");
+}
+
+QStringList SqlConsole::showPlan(QSqlDatabase db, const QString& sql, const bool tableSizes)
+{
+   QStringList scans;
+   QSqlQuery query(db);
+   query.setForwardOnly(true);
+   if (!query.exec("EXPLAIN QUERY PLAN " + sql)) return scans;
+
+   // newer sqlite gives (id, parent, notused, detail), so the plan is a tree; older ones a list
+   const bool tree = (query.record().count() == 4 && query.record().fieldName(0) == "id");
+   const int detailColumn = query.record().count() - 1;
+   QHash<int, QTreeWidgetItem*> items;
+   QList<QPair<QTreeWidgetItem*, QString> > scanned;
+   while (query.next()) {
+      const QString detail = query.value(detailColumn).toString();
+      QTreeWidgetItem* parent = (tree ? items.value(query.value(1).toInt()) : 0);
+      QTreeWidgetItem* item = (parent ? new QTreeWidgetItem(parent) : new QTreeWidgetItem(plan));
+      item->setText(0, detail);
+      if (tree) items.insert(query.value(0).toInt(), item);
+
+      // "SCAN TABLE x" or "SCAN x", but not "SCAN x USING (COVERING) INDEX", reads every row
+      if (detail.startsWith("SCAN ") && !detail.contains(" INDEX ")) {
+         QString table = detail.section(' ', 1, 1);
+         if (table == "TABLE") table = detail.section(' ', 2, 2);
+         scanned << qMakePair(item, table);
+      }
+   }
+   query.finish();
+
+   QFont bold = plan->font();
+   bold.setBold(true);
+   const QStringList tables = db.tables(QSql::AllTables);
+   for (int i = 0; i < scanned.size(); i++) {
+      QTreeWidgetItem* item = scanned[i].first;
+      const QString table = scanned[i].second;
+      // (subqueries and constant rows are scans too, but of nothing on disk)
+      if (!tables.contains(table)) continue;
+      item->setFont(0, bold);
+      item->setForeground(0, Qt::darkRed);
+      // (counting is a scan of its own, so not when just explaining)
+      if (!tableSizes) {
+         scans << table;
+         continue;
+      }
+      const QString escaped = db.driver()->escapeIdentifier(table, QSqlDriver::TableName);
+      if (query.exec("SELECT COUNT(*) FROM " + escaped) && query.next()) {
+         item->setText(1, query.value(0).toString());
+         scans << tr("%1 (%2 rows in the table)").arg(table).arg(query.value(0).toLongLong());
+      }
+      else scans << table;
+      query.finish();
+   }
+   plan->expandAll();
+   plan->resizeColumnToContents(0);
+   return scans;
+}
@@ -0,0 +1,51 @@
+// runs sql typed by the user against the active database, showing how it ran
+#ifndef SQLCONSOLE_H
+#define SQLCONSOLE_H
+
+#include <QSqlDatabase>
+#include <QWidget>
+
+QT_FORWARD_DECLARE_CLASS(QLabel)
+QT_FORWARD_DECLARE_CLASS(QPlainTextEdit)
+QT_FORWARD_DECLARE_CLASS(QSqlQueryModel)
+QT_FORWARD_DECLARE_CLASS(QTableView)
+QT_FORWARD_DECLARE_CLASS(QTreeWidget)
+
+// For tuning the indexes on the parse output.  Each statement is shown with its EXPLAIN QUERY PLAN
+// (full table scans marked, with the table's size when run), how long it took to run and fetch the first
+// rows, and how many rows it returned or changed.  Results go into a QSqlQueryModel, which only
+// fetches rows as the table view scrolls to them, so even a select of a whole slot table shows at once.
+class SqlConsole : public QWidget
+{
+   Q_OBJECT
+public:
+   explicit SqlConsole(QWidget* parent = 0);
+
+   // runs the sql against the database (just explains it, if asked)
+   void exec(QSqlDatabase db, const QString& sql, const bool explainOnly);
+   // lets go of the last results (and the statement they hold open on the database)
+   void clear();
+
+signals:
+   // the user wants the sql run, on the active database
+   void runRequested(const QString& sql, const bool explainOnly);
+
+private slots:
+   void run();
+   void explain();
+   void rowsFetched();
+
+private:
+   // fills in the plan, returning the tables it scans in full (with how many rows each table has, if
+   // asked; that's the most a scan can read, not what the statement actually read)
+   QStringList showPlan(QSqlDatabase db, const QString& sql, const bool tableSizes);
+
+   QPlainTextEdit* sqlEdit;
+   QLabel* status;
+   QTableView* results;
+   QTreeWidget* plan;
+   QSqlQueryModel* model;
+   QString timing;         // how long the last statement took, for the status
+};
+
+#endif // SQLCONSOLE_H
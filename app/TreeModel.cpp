@@ -0,0 +1,217 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the examples of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:BSD$
+** You may use this file under the terms of the BSD license as follows:
+**
+** "Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are
+** met:
+**   * Redistributions of source code must retain the above copyright
+**     notice, this list of conditions and the following disclaimer.
+**   * Redistributions in binary form must reproduce the above copyright
+**     notice, this list of conditions and the following disclaimer in
+**     the documentation and/or other materials provided with the
+**     distribution.
+**   * Neither the name of Digia Plc and its Subsidiary(-ies) nor the names
+**     of its contributors may be used to endorse or promote products derived
+**     from this software without specific prior written permission.
+**
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+** "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+** LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+** A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+** OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+** OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE."
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+/*
+    treemodel.cpp
+
+    Provides a simple tree model to show how to create and use hierarchical
+    models.
+*/
+
+#include "TreeModel.h"
+#include "NameTable.h"
+
+#include <QColor>
+
+//! [0]
+TreeModel::TreeModel(QObject *parent)
+    : QAbstractItemModel(parent)
+{
+}
+//! [0]
+
+//! [1]
+TreeModel::~TreeModel()
+{
+}
+//! [1]
+
+//! [2]
+int TreeModel::columnCount(const QModelIndex &) const
+{
+    return 1;
+}
+//! [2]
+
+//! [3]
+QVariant TreeModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid())
+        return QVariant();
+
+    const Node &node = nodes.at(index.internalId());
+    if (role == Qt::DisplayRole) {
+        const NameTable &names = NameTable::instance();
+        if (node.from < 0)
+            return names.name(node.name);
+        return tr("%1 (from %2)").arg(names.name(node.name), names.name(node.from));
+    }
+    // inherited slots are greyed out
+    if (role == Qt::ForegroundRole && node.from >= 0)
+        return QColor(Qt::gray);
+
+    return QVariant();
+}
+//! [3]
+
+//! [4]
+Qt::ItemFlags TreeModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return 0;
+
+    return QAbstractItemModel::flags(index);
+}
+//! [4]
+
+//! [5]
+QVariant TreeModel::headerData(int section, Qt::Orientation orientation,
+                               int role) const
+{
+    if (section == 0 && orientation == Qt::Horizontal && role == Qt::DisplayRole)
+        return tr("Classes");
+
+    return QVariant();
+}
+//! [5]
+
+//! [6]
+QModelIndex TreeModel::index(int row, int column, const QModelIndex &parent)
+            const
+{
+    if (!hasIndex(row, column, parent))
+        return QModelIndex();
+
+    int node;
+    if (!parent.isValid())
+        node = classNodes.at(row);
+    else
+        node = nodes.at(parent.internalId()).firstChild + row;
+
+    return createIndex(row, column, quintptr(node));
+}
+//! [6]
+
+//! [7]
+QModelIndex TreeModel::parent(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return QModelIndex();
+
+    const int parentNode = nodes.at(index.internalId()).parent;
+    if (parentNode < 0)
+        return QModelIndex();
+
+    return createIndex(nodes.at(parentNode).row, 0, quintptr(parentNode));
+}
+//! [7]
+
+//! [8]
+int TreeModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.column() > 0)
+        return 0;
+
+    if (!parent.isValid())
+        return classNodes.size();
+
+    return nodes.at(parent.internalId()).childCount;
+}
+//! [8]
+
+QModelIndex TreeModel::findClass(const int className) const
+{
+   for (int row = 0; row < classNodes.size(); row++) {
+      if (nodes.at(classNodes[row]).name == className)
+         return createIndex(row, 0, quintptr(classNodes[row]));
+   }
+   return QModelIndex();
+}
+
+QModelIndex TreeModel::findSlot(const QModelIndex &classIndex, const int slotName) const
+{
+   if (!classIndex.isValid()) return QModelIndex();
+
+   const Node& classNode = nodes.at(classIndex.internalId());
+   for (int row = 0; row < classNode.childCount; row++) {
+      const int slotNode = classNode.firstChild + row;
+      if (nodes.at(slotNode).name == slotName)
+         return createIndex(row, 0, quintptr(slotNode));
+   }
+   return QModelIndex();
+}
+
+void TreeModel::addClasses(const QList<TreeModel::Class> &classes)
+{
+   if (classes.isEmpty()) return;
+
+   const int row = classNodes.size();
+   beginInsertRows(QModelIndex(), row, row + classes.size() - 1);
+   for (int i = 0; i < classes.size(); i++) {
+      appendClass(classes[i]);
+   }
+   endInsertRows();
+}
+
+// Classes are added whole, so that the class's slots end up next to each other in the node
+// array, followed by each slot's types (again next to each other).
+void TreeModel::appendClass(const Class &cls)
+{
+   const QList<Slot>& slotList = cls.slotList;
+   const int classNode = nodes.size();
+   const Node cNode = { -1, classNodes.size(), classNode + 1, slotList.size(), cls.name, -1 };
+   nodes.append(cNode);
+   classNodes.append(classNode);
+
+   for (int i = 0; i < slotList.size(); i++) {
+      const Node sNode = { classNode, i, -1, slotList[i].types.size(), slotList[i].name, slotList[i].inheritedFrom };
+      nodes.append(sNode);
+   }
+
+   for (int i = 0; i < slotList.size(); i++) {
+      const int slotNode = classNode + 1 + i;
+      nodes[slotNode].firstChild = nodes.size();
+      const QVector<int>& types = slotList[i].types;
+      for (int j = 0; j < types.size(); j++) {
+         const Node tNode = { slotNode, j, -1, 0, types[j], -1 };
+         nodes.append(tNode);
+      }
+   }
+}
@@ -42,10 +42,10 @@
 #define TREEMODEL_H
 
 #include <QAbstractItemModel>
+#include <QList>
 #include <QModelIndex>
 #include <QVariant>
-
-class TreeItem;
+#include <QVector>
 
 //! [0]
 class TreeModel : public QAbstractItemModel
@@ -53,12 +53,27 @@ class TreeModel : public QAbstractItemModel
     Q_OBJECT
 
 public:
+    // a slot, and the object types it will accept (all as NameTable ids)
+    struct Slot {
+        Slot() : name(-1), inheritedFrom(-1) {}
+        int name;
+        int inheritedFrom;      // class we inherit the slot from, -1 if it is our own
+        QVector<int> types;
+    };
+
+    // a class, and its slots (the class name is a NameTable id)
+    struct Class {
+        int name;
+        QList<Slot> slotList;
+    };
+
     explicit TreeModel(QObject *parent = 0);
     ~TreeModel();
 
-    // add a new class with slots
-    TreeItem* addClass(const QString className);
-    void addSlot(const QString slotName, const QString slotType, TreeItem* parentClass);
+    // index of the class with the given name id (invalid if we don't have it)
+    QModelIndex findClass(const int className) const;
+    // index of the slot with the given name id, under the given class
+    QModelIndex findSlot(const QModelIndex &classIndex, const int slotName) const;
 
     QVariant data(const QModelIndex &index, int role) const;
     Qt::ItemFlags flags(const QModelIndex &index) const;
@@ -70,10 +85,31 @@ public:
     int rowCount(const QModelIndex &parent = QModelIndex()) const;
     int columnCount(const QModelIndex &parent = QModelIndex()) const;
 
+public slots:
+    // append a batch of classes (with their slots), as a single row insertion
+    void addClasses(const QList<TreeModel::Class> &classes);
+
 private:
-    //void setupModelData(const QStringList &lines, TreeItem *parent);
-    TreeItem *rootItem;
+    void appendClass(const Class &cls);
+
+    // A single tree node.  All nodes live in one contiguous array, and the children of a node are
+    // always stored next to each other, so a child is simply firstChild + row.  The model index
+    // internal id is the node's position in the array.  Names are resolved from the shared
+    // NameTable only when the view asks for them.
+    struct Node {
+        int parent;         // parent node, -1 for classes (top level)
+        int row;            // our row under our parent
+        int firstChild;     // position of our first child
+        int childCount;     // number of children
+        int name;           // NameTable id of what we display
+        int from;           // NameTable id of the class an inherited slot comes from, -1 otherwise
+    };
+
+    QVector<Node> nodes;
+    QVector<int> classNodes;    // top level (class) nodes, by row
 };
 //! [0]
 
+Q_DECLARE_METATYPE(QList<TreeModel::Class>)
+
 #endif // TREEMODEL_H
@@ -0,0 +1,24 @@
+TEMPLATE        = app
+TARGET          = oeSql
+
+QT              += sql widgets
+
+CONFIG          += console
+
+HEADERS         = *.h
+SOURCES         = *.cpp
+
+FORMS           = *.ui
+
+INCLUDEPATH     += ../core
+DEPENDPATH      += ../core
+LIBS            += -L../lib -loeSqlCore
+win32-msvc*:PRE_TARGETDEPS += ../lib/oeSqlCore.lib
+else:PRE_TARGETDEPS += ../lib/liboeSqlCore.a
+
+DESTDIR         = ..
+
+OBJECTS_DIR = ./tmp/obj
+MOC_DIR = ./tmp/moc
+RCC_DIR = ./tmp/rcc
+UI_DIR =  ./tmp/ui
@@ -40,6 +40,7 @@
 ****************************************************************************/
 
 #include "Browser.h"
+#include "Cli.h"
 
 #include <QtCore>
 #include <QtWidgets>
@@ -49,6 +50,12 @@
 
 int main(int argc, char *argv[])
 {
+   // headless commands don't need (or want) a display
+   if (Cli::isCommand(argc, argv)) {
+      QCoreApplication app(argc, argv);
+      return Cli::run(app.arguments().mid(1));
+   }
+
    QApplication app(argc, argv);
 
    QMainWindow mainWin;
@@ -66,10 +73,14 @@ int main(int argc, char *argv[])
    fileMenu->addAction(QObject::tr("Close Database..."), &browser, SLOT(closeConnection()));
    fileMenu->addAction(QObject::tr("Close All &Dabases..."), &browser, SLOT(closeAllConnections()));
    fileMenu->addSeparator();
+   fileMenu->addAction(QObject::tr("&Export..."), &browser, SLOT(exportDatabase()));
+   fileMenu->addSeparator();
    fileMenu->addAction(QObject::tr("Quit"), &app, SLOT(quit()));
 
    QMenu *viewMenu = mainWin.menuBar()->addMenu(QObject::tr("View"));
    viewMenu->addAction(QObject::tr("All Objects and &Slots"), &browser, SLOT(viewObjectsAndSlots()));
+   viewMenu->addAction(QObject::tr("Class &Hierarchy"), &browser, SLOT(viewClassHierarchy()));
+   viewMenu->addAction(QObject::tr("&Compare Databases..."), &browser, SLOT(compareDatabases()));
 
    //Lee - deal with the WA_DeleteOnClose causing Widget to crash... find an elegant way to shut down the slot views as well.
 
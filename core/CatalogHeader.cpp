@@ -0,0 +1,242 @@
+#include "CatalogHeader.h"
+
+#include <QHash>
+#include <QIODevice>
+#include <QPair>
+#include <QSet>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QTextStream>
+#include <QVariant>
+
+#include <algorithm>
+
+namespace {
+const quint32 FNV_OFFSET = 2166136261u;
+const quint32 FNV_PRIME = 16777619u;
+
+// biggest buckets get placed first, while the table is emptiest
+struct BucketOrder {
+   explicit BucketOrder(const QVector<QVector<int> >& b) : buckets(b) {}
+   bool operator()(const int a, const int b) const     { return buckets[a].size() > buckets[b].size(); }
+   const QVector<QVector<int> >& buckets;
+};
+}
+
+bool CatalogHeader::write(QSqlDatabase db, QIODevice* out, const QString& nameSpace)
+{
+   struct ClassRow { QString className; QString formName; qint64 baseId; int firstSlot; int slotCount; };
+   struct SlotRow { QString name; int owner; int firstType; int typeCount; };
+
+   QVector<ClassRow> classes;
+   QHash<qint64, int> classIndex;   // class.id -> index
+   QSqlQuery query(db);
+   query.setForwardOnly(true);
+   if (!query.exec("SELECT id, className, formName, baseClass FROM class ORDER BY id")) return false;
+   while (query.next()) {
+      ClassRow row = { query.value(1).toString(), query.value(2).toString(),
+                       (query.value(3).isNull() ? -1 : query.value(3).toLongLong()), 0, 0 };
+      classIndex.insert(query.value(0).toLongLong(), classes.size());
+      classes << row;
+   }
+   if (classes.isEmpty()) return false;
+
+   // slots are grouped by the class declaring them, so each class has a range
+   QVector<SlotRow> slotRows;
+   QHash<qint64, int> slotIndex;    // slotId -> index
+   if (!query.exec("SELECT slotId, slotName, parentId FROM slotTable ORDER BY parentId, slotIndex")) return false;
+   while (query.next()) {
+      const int owner = classIndex.value(query.value(2).toLongLong(), -1);
+      if (owner < 0) continue;
+      SlotRow row = { query.value(1).toString(), owner, 0, 0 };
+      if (classes[owner].slotCount++ == 0) classes[owner].firstSlot = slotRows.size();
+      slotIndex.insert(query.value(0).toLongLong(), slotRows.size());
+      slotRows << row;
+   }
+
+   QVector<int> types;
+   if (!query.exec("SELECT slotId, objId FROM slotObjTable ORDER BY slotId")) return false;
+   QVector<QVector<int> > slotTypes(slotRows.size());
+   while (query.next()) {
+      const int slot = slotIndex.value(query.value(0).toLongLong(), -1);
+      const int type = classIndex.value(query.value(1).toLongLong(), -1);
+      if (slot >= 0 && type >= 0) slotTypes[slot] << type;
+   }
+   for (int i = 0; i < slotRows.size(); i++) {
+      slotRows[i].firstType = types.size();
+      slotRows[i].typeCount = slotTypes[i].size();
+      types += slotTypes[i];
+   }
+
+   // the keys (first one wins if a form or slot name is repeated)
+   QVector<Key> formKeys;
+   QSet<QString> seenForms;
+   for (int i = 0; i < classes.size(); i++) {
+      if (classes[i].formName.isEmpty() || seenForms.contains(classes[i].formName)) continue;
+      seenForms.insert(classes[i].formName);
+      Key key = { -1, classes[i].formName.toUtf8(), i };
+      formKeys << key;
+   }
+   QVector<Key> slotKeys;
+   QSet<QPair<int, QString> > seenSlots;
+   for (int i = 0; i < slotRows.size(); i++) {
+      const QPair<int, QString> name(slotRows[i].owner, slotRows[i].name);
+      if (seenSlots.contains(name)) continue;
+      seenSlots.insert(name);
+      Key key = { slotRows[i].owner, slotRows[i].name.toUtf8(), i };
+      slotKeys << key;
+   }
+
+   QVector<int> formSeeds, formTable, slotSeeds, slotTable;
+   if (!buildTable(formKeys, formSeeds, formTable) || !buildTable(slotKeys, slotSeeds, slotTable)) return false;
+
+   const QString guard = nameSpace.toUpper() + "_H";
+   QTextStream stream(out);
+   stream.setCodec("UTF-8");
+   stream << "// generated by oeSql from " << db.databaseName() << " - do not edit\n"
+          << "#ifndef " << guard << "\n#define " << guard << "\n\n"
+          << "#include <cstdint>\n\n"
+          << "namespace " << nameSpace << " {\n\n"
+          << "struct Class { const char* className; const char* formName; int base; int firstSlot; int slotCount; };\n"
+          << "struct Slot { const char* name; int owner; int firstType; int typeCount; };\n\n"
+          << "constexpr int NUM_CLASSES = " << classes.size() << ";\n"
+          << "constexpr int NUM_SLOTS = " << slotRows.size() << ";\n\n";
+
+   // each array ends with an empty entry, so none of them is ever zero length
+   stream << "constexpr Class classes[] = {\n";
+   for (int i = 0; i < classes.size(); i++) {
+      const ClassRow& row = classes[i];
+      stream << "   { " << quote(row.className) << ", " << quote(row.formName) << ", "
+             << (row.baseId < 0 ? -1 : classIndex.value(row.baseId, -1)) << ", "
+             << row.firstSlot << ", " << row.slotCount << " },\n";
+   }
+   stream << "   { \"\", \"\", -1, 0, 0 }\n};\n\n";
+
+   stream << "constexpr Slot slotEntries[] = {\n";
+   for (int i = 0; i < slotRows.size(); i++) {
+      const SlotRow& row = slotRows[i];
+      stream << "   { " << quote(row.name) << ", " << row.owner << ", " << row.firstType << ", " << row.typeCount << " },\n";
+   }
+   stream << "   { \"\", -1, 0, 0 }\n};\n\n";
+
+   stream << "// class indexes of the types each slot accepts (Slot::firstType, typeCount)\n"
+          << "constexpr int slotTypes[] = { " << join(types + (QVector<int>() << -1)) << " };\n\n";
+
+   stream << "constexpr std::uint32_t FORM_TABLE_SIZE = " << formTable.size() << ";\n"
+          << "constexpr int formSeeds[] = { " << join(formSeeds) << " };\n"
+          << "constexpr int formTable[] = { " << join(formTable) << " };\n\n"
+          << "constexpr std::uint32_t SLOT_TABLE_SIZE = " << slotTable.size() << ";\n"
+          << "constexpr int slotSeeds[] = { " << join(slotSeeds) << " };\n"
+          << "constexpr int slotTable[] = { " << join(slotTable) << " };\n\n";
+
+   stream << "namespace detail {\n"
+          << "constexpr std::uint32_t fnv(std::uint32_t h, const char* s)\n"
+          << "{ return *s ? fnv((h ^ std::uint8_t(*s)) * " << FNV_PRIME << "u, s + 1) : h; }\n"
+          << "constexpr std::uint32_t seed(int d)      { return d ? std::uint32_t(d) : " << FNV_OFFSET << "u; }\n"
+          << "constexpr bool equal(const char* a, const char* b)\n"
+          << "{ return *a == *b && (*a == '\\0' || equal(a + 1, b + 1)); }\n\n"
+          << "constexpr std::uint32_t formHash(int d, const char* name)\n"
+          << "{ return fnv(seed(d), name); }\n"
+          << "constexpr std::uint32_t slotHash(int d, int owner, const char* name)\n"
+          << "{ return fnv((seed(d) ^ std::uint32_t(owner)) * " << FNV_PRIME << "u, name); }\n\n"
+          << "// a negative seed is the position itself (a bucket with a single key)\n"
+          << "constexpr int formPosition(int d, const char* name)\n"
+          << "{ return d < 0 ? -d - 1 : int(formHash(d, name) % FORM_TABLE_SIZE); }\n"
+          << "constexpr int slotPosition(int d, int owner, const char* name)\n"
+          << "{ return d < 0 ? -d - 1 : int(slotHash(d, owner, name) % SLOT_TABLE_SIZE); }\n\n"
+          << "constexpr int formAt(int i, const char* name)\n"
+          << "{ return i >= 0 && *name && equal(classes[i].formName, name) ? i : -1; }\n"
+          << "constexpr int slotAt(int i, int owner, const char* name)\n"
+          << "{ return i >= 0 && slotEntries[i].owner == owner && equal(slotEntries[i].name, name) ? i : -1; }\n"
+          << "}\n\n";
+
+   stream << "// class index of the form, or -1\n"
+          << "constexpr int findForm(const char* formName)\n"
+          << "{\n"
+          << "   return detail::formAt(formTable[detail::formPosition(formSeeds[detail::formHash(0, formName) % FORM_TABLE_SIZE],\n"
+          << "                                                        formName)], formName);\n"
+          << "}\n\n"
+          << "// index of the slot declared by the class, or -1\n"
+          << "constexpr int findSlot(int owner, const char* slotName)\n"
+          << "{\n"
+          << "   return owner < 0 ? -1 :\n"
+          << "          detail::slotAt(slotTable[detail::slotPosition(slotSeeds[detail::slotHash(0, owner, slotName) % SLOT_TABLE_SIZE],\n"
+          << "                                                        owner, slotName)], owner, slotName);\n"
+          << "}\n\n"
+          << "// index of the slot declared by the class or its nearest base class that has it, or -1\n"
+          << "constexpr int findInheritedSlot(int owner, const char* slotName, int depth = 0)\n"
+          << "{\n"
+          << "   return owner < 0 || depth >= 64 ? -1 :\n"
+          << "          findSlot(owner, slotName) >= 0 ? findSlot(owner, slotName) :\n"
+          << "          findInheritedSlot(classes[owner].base, slotName, depth + 1);\n"
+          << "}\n\n"
+          << "} // namespace " << nameSpace << "\n\n"
+          << "#endif // " << guard << "\n";
+   stream.flush();
+   return (stream.status() == QTextStream::Ok);
+}
+
+// hash and displace: keys are put in buckets by hash(0, key); each bucket with several keys gets the
+// first seed that sends all of them to free positions, and single key buckets just take a free
+// position (stored as -position - 1).  The table holds each position's target (-1 if empty).
+bool CatalogHeader::buildTable(const QVector<Key>& keys, QVector<int>& seeds, QVector<int>& table)
+{
+   const int n = qMax(keys.size(), 1);
+   seeds.fill(0, n);
+   table.fill(-1, n);
+
+   QVector<QVector<int> > buckets(n);
+   for (int i = 0; i < keys.size(); i++) buckets[hash(0, keys[i]) % n] << i;
+   QVector<int> order(n);
+   for (int i = 0; i < n; i++) order[i] = i;
+   std::stable_sort(order.begin(), order.end(), BucketOrder(buckets));
+
+   int b = 0;
+   for (; b < n && buckets[order[b]].size() > 1; b++) {
+      const QVector<int>& bucket = buckets[order[b]];
+      QVector<int> positions;
+      for (int seed = 1; positions.size() < bucket.size(); seed++) {
+         if (seed > MAX_SEED) return false;
+         positions.clear();
+         for (int k = 0; k < bucket.size(); k++) {
+            const int position = hash(seed, keys[bucket[k]]) % n;
+            if (table[position] >= 0 || positions.contains(position)) break;
+            positions << position;
+         }
+         if (positions.size() == bucket.size()) seeds[order[b]] = seed;
+      }
+      for (int k = 0; k < bucket.size(); k++) table[positions[k]] = keys[bucket[k]].target;
+   }
+
+   int position = 0;
+   for (; b < n && buckets[order[b]].size() == 1; b++) {
+      while (table[position] >= 0) position++;
+      table[position] = keys[buckets[order[b]][0]].target;
+      seeds[order[b]] = -position - 1;
+   }
+   return true;
+}
+
+// matches detail::formHash and detail::slotHash in the generated header
+quint32 CatalogHeader::hash(const int seed, const Key& key)
+{
+   quint32 h = (seed ? quint32(seed) : FNV_OFFSET);
+   if (key.owner >= 0) h = (h ^ quint32(key.owner)) * FNV_PRIME;
+   for (int i = 0; i < key.name.size(); i++) h = (h ^ quint8(key.name[i])) * FNV_PRIME;
+   return h;
+}
+
+QString CatalogHeader::quote(const QString& text)
+{
+   QString quoted = text;
+   quoted.replace("\\", "\\\\");
+   quoted.replace("\"", "\\\"");
+   return "\"" + quoted + "\"";
+}
+
+QString CatalogHeader::join(const QVector<int>& values)
+{
+   QStringList strings;
+   for (int i = 0; i < values.size(); i++) strings << QString::number(values[i]);
+   return strings.join(", ");
+}
@@ -0,0 +1,40 @@
+// generates a self contained C++ header of a parsed database's forms and slots
+#ifndef CATALOGHEADER_H
+#define CATALOGHEADER_H
+
+#include <QByteArray>
+#include <QSqlDatabase>
+#include <QString>
+#include <QVector>
+
+QT_FORWARD_DECLARE_CLASS(QIODevice)
+
+// Tools that only need to know the forms and slots can compile them in, rather than open the database
+// at startup.  The header holds constexpr arrays of the classes (with their base class and form name),
+// slots and slot types, plus perfect hash tables (hash and displace over FNV-1a) for the form names
+// and for (class, slot name) pairs.  The tables are built here, so the lookups in the header are a
+// couple of array reads and a string compare, usable at compile time, and never allocate.
+class CatalogHeader
+{
+public:
+   // writes the header for the database into the namespace (false if there's nothing to write)
+   static bool write(QSqlDatabase db, QIODevice* out, const QString& nameSpace);
+
+private:
+   // a form name (owner -1), or a slot name and the class index that declares it
+   struct Key {
+      int owner;
+      QByteArray name;
+      int target;       // class or slot index
+   };
+
+   static bool buildTable(const QVector<Key>& keys, QVector<int>& seeds, QVector<int>& table);
+   static quint32 hash(const int seed, const Key& key);
+   static QString quote(const QString& text);
+   static QString join(const QVector<int>& values);
+
+   // largest displacement we try for a bucket, before giving up
+   static const int MAX_SEED = 1 << 24;
+};
+
+#endif // CATALOGHEADER_H
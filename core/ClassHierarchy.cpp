@@ -0,0 +1,91 @@
+#include "ClassHierarchy.h"
+
+#include <QSqlQuery>
+#include <QStringList>
+#include <QVariant>
+
+bool ClassHierarchy::build(QSqlDatabase db)
+{
+   clear(db);
+
+   QSqlQuery query(db);
+   // Class ancestor table
+   // classId: the class, referencing class.id
+   // ancestorId: the class itself (depth 0) or one of its base classes, referencing class.id
+   // depth: number of inheritance levels between them
+   query.exec("create table classAncestor (classId integer, ancestorId integer, depth integer)");
+
+   db.transaction();
+   query.exec(QString("insert into classAncestor "
+                      "WITH RECURSIVE ancestor(classId, ancestorId, depth) AS ("
+                      "SELECT id, id, 0 FROM class "
+                      "UNION ALL "
+                      "SELECT ancestor.classId, class.baseClass, ancestor.depth + 1 FROM ancestor "
+                      "JOIN class ON class.id = ancestor.ancestorId "
+                      "WHERE class.baseClass IS NOT NULL AND ancestor.depth < %1) "
+                      "SELECT classId, ancestorId, depth FROM ancestor").arg(MAX_DEPTH));
+   query.exec("create index classAncestorIdx on classAncestor (classId, depth)");
+   query.exec("create index ancestorClassIdx on classAncestor (ancestorId, depth)");
+   query.exec("create index if not exists slotParentIdx on slotTable (parentId, slotIndex)");
+   query.exec("create index if not exists classIdIdx on class (id)");
+
+   // Slot acceptor table
+   // classId: a class that can be given to the slot, referencing class.id
+   // depth: how far up classId's hierarchy the slot's type is (0 if it's classId itself)
+   // ownerId: class declaring the slot, referencing class.id
+   // slotId: the slot, referencing slotTable.slotId
+   // typeId: the type the slot accepts, referencing class.id
+   query.exec("create table slotAcceptor (classId integer, depth integer, ownerId integer, slotId integer, typeId integer, "
+              "primary key (classId, depth, ownerId, slotId, typeId)) without rowid");
+   query.exec("insert or ignore into slotAcceptor "
+              "SELECT classAncestor.classId, classAncestor.depth, slotTable.parentId, slotTable.slotId, slotObjTable.objId "
+              "FROM classAncestor JOIN slotObjTable ON slotObjTable.objId = classAncestor.ancestorId "
+              "JOIN slotTable ON slotTable.slotId = slotObjTable.slotId");
+
+   // Effective slot view
+   // classId: the class accepting the slot
+   // slotId, slotName, slotIndex: the slot, referencing slotTable.slotId
+   // declaringClassId: class the slot is declared in, referencing class.id
+   // depth: 0 for the class's own slots, otherwise how far up it was inherited from
+   query.exec("create view effectiveSlot AS "
+              "SELECT classAncestor.classId AS classId, slotTable.slotId AS slotId, slotTable.slotName AS slotName, "
+              "slotTable.slotIndex AS slotIndex, classAncestor.ancestorId AS declaringClassId, classAncestor.depth AS depth "
+              "FROM classAncestor JOIN slotTable ON slotTable.parentId = classAncestor.ancestorId");
+   return db.commit();
+}
+
+void ClassHierarchy::clear(QSqlDatabase db)
+{
+   QSqlQuery query(db);
+   query.exec("DROP VIEW IF EXISTS effectiveSlot");
+   query.exec("DROP TABLE IF EXISTS slotAcceptor");
+   query.exec("DROP TABLE IF EXISTS classAncestor");
+}
+
+bool ClassHierarchy::exists(QSqlDatabase db)
+{
+   return db.tables(QSql::Views).contains("effectiveSlot") && db.tables().contains("slotAcceptor");
+}
+
+QList<ClassHierarchy::Acceptor> ClassHierarchy::acceptors(QSqlDatabase db, const QString& className)
+{
+   QList<Acceptor> found;
+   QSqlQuery query(db);
+   query.setForwardOnly(true);
+   query.prepare("SELECT owner.className, slotTable.slotName, type.className, slotAcceptor.depth FROM slotAcceptor "
+                 "JOIN class AS owner ON owner.id = slotAcceptor.ownerId "
+                 "JOIN slotTable ON slotTable.slotId = slotAcceptor.slotId "
+                 "JOIN class AS type ON type.id = slotAcceptor.typeId "
+                 "WHERE slotAcceptor.classId IN (SELECT id FROM class WHERE className = ? "
+                 "UNION SELECT id FROM class WHERE formName = ?) "
+                 "ORDER BY slotAcceptor.depth, owner.className, slotTable.slotName");
+   query.addBindValue(className);
+   query.addBindValue(className);
+   if (!query.exec()) return found;
+   while (query.next()) {
+      Acceptor acceptor = { query.value(0).toString(), query.value(1).toString(), query.value(2).toString(),
+                            query.value(3).toInt() };
+      found << acceptor;
+   }
+   return found;
+}
@@ -0,0 +1,40 @@
+// materialized class inheritance, and the slots each class accepts through it
+#ifndef CLASSHIERARCHY_H
+#define CLASSHIERARCHY_H
+
+#include <QList>
+#include <QSqlDatabase>
+#include <QString>
+
+// An OpenEaagles object accepts its base classes' slots too, but the class table only knows each
+// class's direct baseClass.  At parse time we walk that once and store the full ancestor closure
+// (classAncestor), so that "every slot this class accepts" is a single indexed lookup through the
+// effectiveSlot view, rather than a query per level of inheritance.  The same closure, joined with
+// slotObjTable, gives the reverse: every slot that a class can be given to (slotAcceptor), clustered
+// by class so that's a single range read too.
+class ClassHierarchy
+{
+public:
+   // a slot that accepts a class
+   struct Acceptor {
+      QString owner;    // class declaring the slot
+      QString slot;
+      QString type;     // what the slot asks for: the class, or one of its bases
+      int depth;        // how far up the class's hierarchy the type is
+   };
+
+   // (re)builds the ancestor closure and the effective slot view from the class and slot tables
+   static bool build(QSqlDatabase db);
+   // removes them
+   static void clear(QSqlDatabase db);
+   // true if the database has them
+   static bool exists(QSqlDatabase db);
+
+   // the slots the class (by class or form name) can be given to, closest type first
+   static QList<Acceptor> acceptors(QSqlDatabase db, const QString& className);
+
+   // deepest inheritance we follow, so a bad baseClass loop can't run forever
+   static const int MAX_DEPTH = 64;
+};
+
+#endif // CLASSHIERARCHY_H
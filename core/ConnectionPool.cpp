@@ -0,0 +1,88 @@
+#include "ConnectionPool.h"
+
+#include <QAtomicInt>
+#include <QSqlQuery>
+
+// prefix of our own connection names
+static const char* INTERNAL_PREFIX = "oeSql:";
+
+ConnectionPool& ConnectionPool::instance()
+{
+   static ConnectionPool pool;
+   return pool;
+}
+
+ConnectionPool::ConnectionPool()
+{
+}
+
+ConnectionPool::ThreadConnections::~ThreadConnections()
+{
+   QHash<QString, QPair<QString, int> >::const_iterator it;
+   for (it = readers.constBegin(); it != readers.constEnd(); ++it) {
+      QSqlDatabase::removeDatabase(it.value().first);
+   }
+}
+
+void ConnectionPool::addDatabase(QSqlDatabase db)
+{
+   // WAL lets the readers carry on while we write, and makes normal syncing safe
+   QSqlQuery query(db);
+   query.exec("PRAGMA journal_mode=WAL");
+   query.exec("PRAGMA synchronous=NORMAL");
+   query.exec(QString("PRAGMA busy_timeout=%1").arg(BUSY_TIMEOUT));
+
+   QMutexLocker locker(&mutex);
+   drivers.insert(db.connectionName(), db.driverName());
+}
+
+void ConnectionPool::removeDatabase(const QString& dbName)
+{
+   QMutexLocker locker(&mutex);
+   drivers.remove(dbName);
+   generations[dbName]++;
+}
+
+QSqlDatabase ConnectionPool::reader(const QString& dbName)
+{
+   QMutexLocker locker(&mutex);
+   if (!drivers.contains(dbName)) return QSqlDatabase();
+
+   if (!threadConnections.hasLocalData()) threadConnections.setLocalData(new ThreadConnections);
+   QHash<QString, QPair<QString, int> >& readers = threadConnections.localData()->readers;
+   const int generation = generations.value(dbName);
+
+   QHash<QString, QPair<QString, int> >::iterator it = readers.find(dbName);
+   if (it != readers.end()) {
+      if (it.value().second == generation) return QSqlDatabase::database(it.value().first);
+      // the database has been closed (and maybe reopened) since, start over
+      QSqlDatabase::removeDatabase(it.value().first);
+      readers.erase(it);
+   }
+
+   const QString connName = internalConnectionName("reader");
+   {
+      QSqlDatabase db = QSqlDatabase::addDatabase(drivers.value(dbName), connName);
+      db.setDatabaseName(dbName);
+      db.setConnectOptions(QString("QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=%1").arg(BUSY_TIMEOUT));
+      db.open();
+   }
+   readers.insert(dbName, qMakePair(connName, generation));
+   return QSqlDatabase::database(connName);
+}
+
+QSqlDatabase ConnectionPool::writer(const QString& dbName) const
+{
+   return QSqlDatabase::database(dbName);
+}
+
+QString ConnectionPool::internalConnectionName(const QString& kind)
+{
+   static QAtomicInt nextConnection(0);
+   return QString("%1%2:%3").arg(INTERNAL_PREFIX, kind).arg(nextConnection.fetchAndAddRelaxed(1));
+}
+
+bool ConnectionPool::isInternalConnection(const QString& name)
+{
+   return name.startsWith(QLatin1String(INTERNAL_PREFIX));
+}
@@ -0,0 +1,56 @@
+// per thread read connections, and a single write connection, for each database file
+#ifndef CONNECTIONPOOL_H
+#define CONNECTIONPOOL_H
+
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QSqlDatabase>
+#include <QString>
+#include <QThreadStorage>
+
+// Qt database connections can't be used across threads.  The user's connection to a database (named
+// after the file) is its one write connection, and lives on the gui thread.  Any thread that wants to
+// read the database asks the pool, and gets a read only connection of its own, opened on first use
+// and kept for the life of the thread.  Write connections are put in WAL mode, so readers on other
+// threads never block on (or get blocked by) the writer.
+class ConnectionPool
+{
+public:
+   static ConnectionPool& instance();
+
+   // adds a newly opened user database to the pool, making it the write connection (gui thread only)
+   void addDatabase(QSqlDatabase db);
+   // the database was closed, the readers for it are dropped as their threads next use them (or end)
+   void removeDatabase(const QString& dbName);
+
+   // a read only connection to the database for the calling thread (invalid if it isn't open)
+   QSqlDatabase reader(const QString& dbName);
+   // the write connection to the database (gui thread only)
+   QSqlDatabase writer(const QString& dbName) const;
+
+   // a new, unique name for one of our own connections (readers, staging databases)
+   static QString internalConnectionName(const QString& kind);
+   // true if the connection name is one of our own (and not a user database)
+   static bool isInternalConnection(const QString& name);
+
+   // how long a connection waits on a lock before giving up (msecs)
+   static const int BUSY_TIMEOUT = 5000;
+
+private:
+   ConnectionPool();
+   Q_DISABLE_COPY(ConnectionPool)
+
+   // a thread's readers, removed when the thread ends
+   struct ThreadConnections {
+      ~ThreadConnections();
+      QHash<QString, QPair<QString, int> > readers;   // database -> connection name, generation
+   };
+
+   QMutex mutex;
+   QHash<QString, QString> drivers;       // open databases -> driver
+   QHash<QString, int> generations;       // bumped each time a database is closed
+   QThreadStorage<ThreadConnections*> threadConnections;
+};
+
+#endif // CONNECTIONPOOL_H
@@ -0,0 +1,160 @@
+#include "DatabaseDiff.h"
+
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QVariant>
+
+// the key (name columns) of the current row, or an empty list when we've run out
+static QStringList currentKey(QSqlQuery& query, const bool valid, const int keyColumns)
+{
+   QStringList key;
+   if (valid) {
+      for (int i = 0; i < keyColumns; i++) key << query.value(i).toString();
+   }
+   return key;
+}
+
+QList<DatabaseDiff::Change> DatabaseDiff::compare(QSqlDatabase oldDb, QSqlDatabase newDb)
+{
+   QList<Change> changes;
+   compareClasses(oldDb, newDb, changes);
+   compareSet(oldDb, newDb,
+              "SELECT class.className, slotTable.slotName FROM slotTable "
+              "JOIN class ON class.id = slotTable.parentId "
+              "WHERE class.className IS NOT NULL AND slotTable.slotName IS NOT NULL "
+              "ORDER BY 1, 2",
+              Slot, changes);
+   compareSet(oldDb, newDb,
+              "SELECT owner.className, slotTable.slotName, type.className FROM slotObjTable "
+              "JOIN slotTable ON slotTable.slotId = slotObjTable.slotId "
+              "JOIN class AS owner ON owner.id = slotTable.parentId "
+              "JOIN class AS type ON type.id = slotObjTable.objId "
+              "WHERE owner.className IS NOT NULL AND slotTable.slotName IS NOT NULL AND type.className IS NOT NULL "
+              "ORDER BY 1, 2, 3",
+              SlotType, changes);
+   return changes;
+}
+
+// classes are matched by name, and then their base class and form name compared
+void DatabaseDiff::compareClasses(QSqlDatabase oldDb, QSqlDatabase newDb, QList<Change>& changes)
+{
+   const QString sql = "SELECT class.className, base.className, class.formName FROM class "
+                       "LEFT JOIN class AS base ON base.id = class.baseClass "
+                       "WHERE class.className IS NOT NULL ORDER BY 1";
+   QSqlQuery oldQuery(oldDb);
+   oldQuery.setForwardOnly(true);
+   oldQuery.exec(sql);
+   QSqlQuery newQuery(newDb);
+   newQuery.setForwardOnly(true);
+   newQuery.exec(sql);
+
+   bool moreOld = oldQuery.next();
+   bool moreNew = newQuery.next();
+   while (moreOld || moreNew) {
+      const QStringList oldKey = currentKey(oldQuery, moreOld, 1);
+      const QStringList newKey = currentKey(newQuery, moreNew, 1);
+      const int cmp = (!moreOld ? 1 : (!moreNew ? -1 : compareKeys(oldKey, newKey)));
+      Change change;
+      change.what = Class;
+      if (cmp < 0) {
+         change.how = Removed;
+         change.name = oldKey[0];
+         changes << change;
+         moreOld = oldQuery.next();
+      }
+      else if (cmp > 0) {
+         change.how = Added;
+         change.name = newKey[0];
+         changes << change;
+         moreNew = newQuery.next();
+      }
+      else {
+         change.how = Changed;
+         change.name = oldKey[0];
+         for (int column = 1; column <= 2; column++) {
+            const QString oldValue = oldQuery.value(column).toString();
+            const QString newValue = newQuery.value(column).toString();
+            if (oldValue != newValue) {
+               change.what = (column == 1 ? BaseClass : FormName);
+               change.oldValue = oldValue;
+               change.newValue = newValue;
+               changes << change;
+            }
+         }
+         moreOld = oldQuery.next();
+         moreNew = newQuery.next();
+      }
+   }
+}
+
+// rows that only have names (slots, slot types) are either there or not
+void DatabaseDiff::compareSet(QSqlDatabase oldDb, QSqlDatabase newDb, const QString& sql, const What what, QList<Change>& changes)
+{
+   QSqlQuery oldQuery(oldDb);
+   oldQuery.setForwardOnly(true);
+   oldQuery.exec(sql);
+   QSqlQuery newQuery(newDb);
+   newQuery.setForwardOnly(true);
+   newQuery.exec(sql);
+
+   const int keyColumns = oldQuery.record().count();
+   bool moreOld = oldQuery.next();
+   bool moreNew = newQuery.next();
+   while (moreOld || moreNew) {
+      const QStringList oldKey = currentKey(oldQuery, moreOld, keyColumns);
+      const QStringList newKey = currentKey(newQuery, moreNew, keyColumns);
+      const int cmp = (!moreOld ? 1 : (!moreNew ? -1 : compareKeys(oldKey, newKey)));
+      if (cmp == 0) {
+         moreOld = oldQuery.next();
+         moreNew = newQuery.next();
+         continue;
+      }
+
+      const QStringList& key = (cmp < 0 ? oldKey : newKey);
+      Change change;
+      change.what = what;
+      change.how = (cmp < 0 ? Removed : Added);
+      change.name = key[0] + "." + key[1];
+      if (what == SlotType) {
+         if (cmp < 0) change.oldValue = key[2];
+         else change.newValue = key[2];
+      }
+      changes << change;
+      if (cmp < 0) moreOld = oldQuery.next();
+      else moreNew = newQuery.next();
+   }
+}
+
+// same ordering as sqlite's (binary) ORDER BY, for the ascii names we have
+int DatabaseDiff::compareKeys(const QStringList& a, const QStringList& b)
+{
+   for (int i = 0; i < a.size() && i < b.size(); i++) {
+      const int cmp = QString::compare(a[i], b[i], Qt::CaseSensitive);
+      if (cmp != 0) return cmp;
+   }
+   return a.size() - b.size();
+}
+
+QString DatabaseDiff::describe(const Change& change)
+{
+   static const char* hows[] = { "+", "-", "~" };
+   QString line = QString("%1 ").arg(hows[change.how]);
+   switch (change.what) {
+      case Class:
+         line.append("class " + change.name);
+         break;
+      case BaseClass:
+         line.append(QString("class %1 base class: %2 -> %3").arg(change.name, change.oldValue, change.newValue));
+         break;
+      case FormName:
+         line.append(QString("class %1 form name: %2 -> %3").arg(change.name, change.oldValue, change.newValue));
+         break;
+      case Slot:
+         line.append("slot " + change.name);
+         break;
+      case SlotType:
+         line.append(QString("slot type %1: %2").arg(change.name, change.how == Removed ? change.oldValue : change.newValue));
+         break;
+   }
+   return line;
+}
@@ -0,0 +1,40 @@
+// structural differences between two parsed databases
+#ifndef DATABASEDIFF_H
+#define DATABASEDIFF_H
+
+#include <QList>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+// Compares two oeSql databases by qualified name (ids are hashes of the names, but a collision moves
+// one on, and older databases numbered them in the order the source tree was walked, so they aren't
+// compared).  Each side is read sorted by name, with forward only cursors, and the two streams are
+// merged, so memory doesn't grow with the database size.
+class DatabaseDiff
+{
+public:
+   enum What { Class, BaseClass, FormName, Slot, SlotType };
+   enum How { Added, Removed, Changed };
+
+   struct Change {
+      What what;
+      How how;
+      QString name;        // class, or class.slot
+      QString oldValue;    // base class, form name or slot type (when it applies)
+      QString newValue;
+   };
+
+   // everything that changed going from the old to the new database
+   static QList<Change> compare(QSqlDatabase oldDb, QSqlDatabase newDb);
+
+   // one line description of the change
+   static QString describe(const Change& change);
+
+private:
+   static void compareClasses(QSqlDatabase oldDb, QSqlDatabase newDb, QList<Change>& changes);
+   static void compareSet(QSqlDatabase oldDb, QSqlDatabase newDb, const QString& sql, const What what, QList<Change>& changes);
+   static int compareKeys(const QStringList& a, const QStringList& b);
+};
+
+#endif // DATABASEDIFF_H
@@ -0,0 +1,64 @@
+#include "DatabaseInfo.h"
+#include "ConnectionPool.h"
+
+#include <QFileInfo>
+#include <QSqlDriver>
+#include <QSqlQuery>
+#include <QVariant>
+
+QString DatabaseInfo::fingerprint(QSqlDatabase db)
+{
+   QString print;
+   const QString fileName = db.databaseName();
+   const QFileInfo files[2] = { QFileInfo(fileName), QFileInfo(fileName + "-wal") };
+   for (int i = 0; i < 2; i++) {
+      if (files[i].exists()) {
+         print.append(QString("%1:%2;").arg(files[i].size()).arg(files[i].lastModified().toMSecsSinceEpoch()));
+      }
+   }
+   QSqlQuery query(db);
+   if (query.exec("PRAGMA schema_version") && query.next()) {
+      print.append(query.value(0).toString());
+   }
+   return print;
+}
+
+DatabaseInfoLoader::DatabaseInfoLoader(const QString& name, const QString& print)
+   : dbName(name), fingerprint(print)
+{
+   qRegisterMetaType<DatabaseInfo>("DatabaseInfo");
+
+   // we delete ourselves (on the gui thread) when finished
+   setAutoDelete(false);
+}
+
+void DatabaseInfoLoader::run()
+{
+   DatabaseInfo info;
+   info.stamp = fingerprint;
+   {
+      QSqlDatabase db = ConnectionPool::instance().reader(dbName);
+      if (db.isOpen()) {
+         QSqlQuery query(db);
+         query.setForwardOnly(true);
+         const QStringList tables = db.tables();
+         for (int i = 0; i < tables.size(); i++) {
+            qint64 rows = -1;
+            const QString table = db.driver()->escapeIdentifier(tables[i], QSqlDriver::TableName);
+            if (query.exec("SELECT COUNT(*) FROM " + table) && query.next()) rows = query.value(0).toLongLong();
+            info.tables << qMakePair(tables[i], rows);
+         }
+         if (query.exec("PRAGMA schema_version") && query.next()) {
+            info.schemaVersion = query.value(0).toInt();
+         }
+         if (tables.contains("parseInfo") && query.exec("SELECT sourceDir, parseTime FROM parseInfo") && query.next()) {
+            info.sourceDir = query.value(0).toString();
+            info.parseTime = QDateTime::fromString(query.value(1).toString(), Qt::ISODate);
+         }
+         info.valid = true;
+      }
+   }
+
+   emit loaded(dbName, info);
+   deleteLater();
+}
@@ -0,0 +1,52 @@
+// cached metadata about an open database, loaded in the background
+#ifndef DATABASEINFO_H
+#define DATABASEINFO_H
+
+#include <QDateTime>
+#include <QList>
+#include <QMetaType>
+#include <QObject>
+#include <QPair>
+#include <QRunnable>
+#include <QSqlDatabase>
+#include <QStringList>
+
+// what the connection tree shows about a database
+struct DatabaseInfo
+{
+   DatabaseInfo() : schemaVersion(0), valid(false) {}
+
+   // Identifies the state of a database file cheaply (no table scans): the file's (and its write
+   // ahead log's) size and modification time, plus sqlite's schema version.  If this hasn't changed,
+   // neither has anything we cache.
+   static QString fingerprint(QSqlDatabase db);
+
+   QString stamp;                               // fingerprint this info was loaded at
+   QList< QPair<QString, qint64> > tables;      // table names, and their row counts
+   int schemaVersion;                           // sqlite's schema version
+   QDateTime parseTime;                         // when we parsed it (if we know)
+   QString sourceDir;                           // what we parsed (if we know)
+   bool valid;
+};
+
+Q_DECLARE_METATYPE(DatabaseInfo)
+
+// Loads a DatabaseInfo on a thread pool thread, through a pooled read connection, and deletes itself
+// when done.
+class DatabaseInfoLoader : public QObject, public QRunnable
+{
+   Q_OBJECT
+public:
+   DatabaseInfoLoader(const QString& dbName, const QString& fingerprint);
+
+   virtual void run();
+
+signals:
+   void loaded(const QString& dbName, const DatabaseInfo& info);
+
+private:
+   QString dbName;
+   QString fingerprint;
+};
+
+#endif // DATABASEINFO_H
@@ -0,0 +1,158 @@
+#include "Exporter.h"
+#include "ConnectionPool.h"
+
+#include <QFile>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QStringList>
+#include <QTextStream>
+#include <QVariant>
+
+qint64 Exporter::write(QSqlDatabase db, const Data data, const Format format, QIODevice* out, QString* error)
+{
+   QString sql;
+   QStringList columns;
+   switch (data) {
+      case Classes:
+         sql = "SELECT class.id, class.className, class.formName, class.fileName, base.className FROM class "
+               "LEFT JOIN class AS base ON base.id = class.baseClass ORDER BY class.className, class.rowid";
+         columns << "id" << "className" << "formName" << "fileName" << "baseClass";
+         break;
+      case Slots:
+         // driven from class, so classNameIdx and slotParentIdx give the order without a sort
+         sql = "SELECT slotTable.slotId, slotTable.slotName, class.className FROM class "
+               "JOIN slotTable ON slotTable.parentId = class.id ORDER BY class.className, class.rowid, slotTable.slotIndex";
+         columns << "slotId" << "slotName" << "className";
+         break;
+      case SlotTypes:
+         sql = "SELECT slotObjTable.slotId, slotTable.slotName, owner.className, type.className FROM slotObjTable "
+               "LEFT JOIN slotTable ON slotTable.slotId = slotObjTable.slotId "
+               "LEFT JOIN class AS owner ON owner.id = slotTable.parentId "
+               "LEFT JOIN class AS type ON type.id = slotObjTable.objId ORDER BY slotObjTable.rowid";
+         columns << "slotId" << "slotName" << "className" << "objectType";
+         break;
+   }
+
+   QSqlQuery query(db);
+   query.setForwardOnly(true);
+   if (!query.exec(sql)) {
+      if (error) *error = query.lastError().text();
+      return -1;
+   }
+
+   QTextStream stream(out);
+   stream.setCodec("UTF-8");
+   qint64 rows = 0;
+   if (format == Csv) {
+      stream << columns.join(",") << "\n";
+      while (query.next()) {
+         for (int c = 0; c < columns.size(); c++) {
+            if (c > 0) stream << ",";
+            stream << csvField(query.value(c));
+         }
+         stream << "\n";
+         rows++;
+      }
+   }
+   else {
+      stream << "[";
+      while (query.next()) {
+         stream << (rows == 0 ? "\n{" : ",\n{");
+         for (int c = 0; c < columns.size(); c++) {
+            if (c > 0) stream << ",";
+            stream << "\"" << columns[c] << "\":" << jsonValue(query.value(c));
+         }
+         stream << "}";
+         rows++;
+      }
+      stream << "\n]\n";
+   }
+   stream.flush();
+   if (query.lastError().isValid()) {
+      // stopped part way through the rows
+      if (error) *error = query.lastError().text();
+      return -1;
+   }
+   if (stream.status() != QTextStream::Ok) {
+      if (error) *error = out->errorString();
+      return -1;
+   }
+   return rows;
+}
+
+bool Exporter::dataFromName(const QString& name, Data& data)
+{
+   const QString lower = name.toLower();
+   if (lower == "classes") data = Classes;
+   else if (lower == "slots") data = Slots;
+   else if (lower == "slottypes") data = SlotTypes;
+   else return false;
+   return true;
+}
+
+bool Exporter::formatFromName(const QString& name, Format& format)
+{
+   const QString lower = name.toLower();
+   if (lower == "csv" || lower.endsWith(".csv")) format = Csv;
+   else if (lower == "json" || lower.endsWith(".json")) format = Json;
+   else return false;
+   return true;
+}
+
+// quoted only when it has to be
+QString Exporter::csvField(const QVariant& value)
+{
+   if (value.isNull()) return QString();
+   QString field = value.toString();
+   if (field.contains(',') || field.contains('"') || field.contains('\n') || field.contains('\r')) {
+      field.replace("\"", "\"\"");
+      field.prepend('"');
+      field.append('"');
+   }
+   return field;
+}
+
+QString Exporter::jsonValue(const QVariant& value)
+{
+   if (value.isNull()) return "null";
+   if (value.type() == QVariant::Int || value.type() == QVariant::LongLong) return value.toString();
+
+   const QString text = value.toString();
+   QString json = "\"";
+   for (int i = 0; i < text.size(); i++) {
+      const QChar ch = text[i];
+      switch (ch.unicode()) {
+         case '"':  json.append("\\\""); break;
+         case '\\': json.append("\\\\"); break;
+         case '\n': json.append("\\n"); break;
+         case '\r': json.append("\\r"); break;
+         case '\t': json.append("\\t"); break;
+         default:
+            if (ch.unicode() < 0x20) json.append(QString("\\u%1").arg(ch.unicode(), 4, 16, QChar('0')));
+            else json.append(ch);
+      }
+   }
+   json.append("\"");
+   return json;
+}
+
+ExportTask::ExportTask(const QString& name, const Exporter::Data what, const Exporter::Format how, const QString& file)
+   : dbName(name), data(what), format(how), fileName(file)
+{
+   // we delete ourselves (on the gui thread) when finished
+   setAutoDelete(false);
+}
+
+void ExportTask::run()
+{
+   qint64 rows = -1;
+   QFile file(fileName);
+   QSqlDatabase db = ConnectionPool::instance().reader(dbName);
+   if (db.isOpen() && file.open(QFile::WriteOnly | QFile::Truncate)) {
+      rows = Exporter::write(db, data, format, &file);
+      file.close();
+   }
+   emit finished(fileName, rows);
+   deleteLater();
+}
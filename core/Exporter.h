@@ -0,0 +1,54 @@
+// streams the class and slot tables out as csv or json
+#ifndef EXPORTER_H
+#define EXPORTER_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QSqlDatabase>
+#include <QString>
+
+QT_FORWARD_DECLARE_CLASS(QIODevice)
+
+// Each export is a single forward only query (with the ids resolved to names), written out a row at
+// a time, so memory stays the same however big the database is.
+class Exporter
+{
+public:
+   enum Data { Classes, Slots, SlotTypes };
+   enum Format { Csv, Json };
+
+   // writes the data to the device, returning the number of rows (-1 on error, with the query's or
+   // device's error in error, if given)
+   static qint64 write(QSqlDatabase db, const Data data, const Format format, QIODevice* out, QString* error = 0);
+
+   // "classes", "slots" or "slottypes"
+   static bool dataFromName(const QString& name, Data& data);
+   // "csv" or "json" (also accepts file names, going by the suffix)
+   static bool formatFromName(const QString& name, Format& format);
+
+private:
+   static QString csvField(const QVariant& value);
+   static QString jsonValue(const QVariant& value);
+};
+
+// Runs an export to a file on a thread pool thread, through a pooled read connection, and deletes
+// itself when done.
+class ExportTask : public QObject, public QRunnable
+{
+   Q_OBJECT
+public:
+   ExportTask(const QString& dbName, const Exporter::Data data, const Exporter::Format format, const QString& fileName);
+
+   virtual void run();
+
+signals:
+   void finished(const QString& fileName, const qint64 rows);
+
+private:
+   QString dbName;
+   Exporter::Data data;
+   Exporter::Format format;
+   QString fileName;
+};
+
+#endif // EXPORTER_H
@@ -0,0 +1,411 @@
+#include "InputChecker.h"
+#include "ClassHierarchy.h"
+
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QSet>
+#include <QSqlQuery>
+#include <QThreadPool>
+#include <QVariant>
+
+#include <algorithm>
+
+struct InputChecker::Token {
+   enum Type { Open, Close, ListOpen, ListClose, Slot, Word, End };
+   Token() : type(End), line(0), column(0) {}
+   Type type;
+   QString text;
+   int line;
+   int column;       // from 0, in utf-16 code units
+};
+
+// splits an input file into parens, braces, "slot:" names and words (numbers, strings, names),
+// skipping comments and preprocessor lines
+class InputChecker::Scanner
+{
+public:
+   explicit Scanner(const QString& input) : text(input), pos(0), line(1), lineBegin(0), lineStart(true) {}
+
+   Token next()
+   {
+      skipSpace();
+      Token token;
+      token.line = line;
+      token.column = pos - lineBegin;
+      if (pos >= text.size()) return token;
+
+      const QChar ch = text[pos];
+      if (ch == '(') { token.type = Token::Open; pos++; }
+      else if (ch == ')') { token.type = Token::Close; pos++; }
+      else if (ch == '{') { token.type = Token::ListOpen; pos++; }
+      else if (ch == '}') { token.type = Token::ListClose; pos++; }
+      else if (ch == '"') {
+         const int start = pos++;
+         while (pos < text.size() && text[pos] != '"' && text[pos] != '\n') {
+            if (text[pos] == '\\') pos++;
+            pos++;
+         }
+         pos++;
+         token.type = Token::Word;
+         token.text = text.mid(start, pos - start);
+      }
+      else {
+         const int start = pos;
+         while (pos < text.size() && !isDelimiter(text[pos])) pos++;
+         token.text = text.mid(start, pos - start);
+         if (token.text.size() > 1 && token.text.endsWith(':')) {
+            token.type = Token::Slot;
+            token.text.chop(1);
+         }
+         else token.type = Token::Word;
+      }
+      lineStart = false;
+      return token;
+   }
+
+private:
+   static bool isDelimiter(const QChar ch)
+   {
+      return ch.isSpace() || ch == '(' || ch == ')' || ch == '{' || ch == '}' || ch == '"';
+   }
+
+   void skipSpace()
+   {
+      while (pos < text.size()) {
+         const QChar ch = text[pos];
+         if (ch == '\n') { line++; pos++; lineBegin = pos; lineStart = true; }
+         else if (ch.isSpace()) pos++;
+         else if (ch == '#' && lineStart) skipLine();
+         else if (ch == '/' && pos + 1 < text.size() && text[pos + 1] == '/') skipLine();
+         else if (ch == '/' && pos + 1 < text.size() && text[pos + 1] == '*') {
+            pos += 2;
+            while (pos < text.size() && !(text[pos] == '*' && pos + 1 < text.size() && text[pos + 1] == '/')) {
+               if (text[pos] == '\n') { line++; lineBegin = pos + 1; }
+               pos++;
+            }
+            pos += 2;
+         }
+         else break;
+      }
+   }
+
+   void skipLine()
+   {
+      while (pos < text.size() && text[pos] != '\n') pos++;
+   }
+
+   const QString& text;
+   int pos;
+   int line;
+   int lineBegin;       // where this line starts in the text
+   bool lineStart;      // nothing but white space so far on this line
+};
+
+// checks one file into its slot in the results
+class InputCheckTask : public QRunnable
+{
+public:
+   InputCheckTask(const InputChecker* c, const QString& file, QList<InputChecker::Problem>* out)
+      : checker(c), fileName(file), problems(out) {}
+
+   virtual void run()         { *problems = checker->checkFile(fileName); }
+
+private:
+   const InputChecker* checker;
+   QString fileName;
+   QList<InputChecker::Problem>* problems;
+};
+
+InputChecker::InputChecker()
+{
+}
+
+bool InputChecker::load(QSqlDatabase db)
+{
+   forms.clear();
+   sortedForms.clear();
+   classes.clear();
+   slotTypes.clear();
+
+   QSqlQuery query(db);
+   query.setForwardOnly(true);
+   if (!query.exec("SELECT id, className, formName, baseClass, fileName FROM class")) return false;
+   while (query.next()) {
+      ClassEntry& entry = classes[query.value(0).toLongLong()];
+      entry.name = query.value(1).toString();
+      entry.formName = query.value(2).toString();
+      entry.fileName = query.value(4).toString();
+      entry.base = (query.value(3).isNull() ? -1 : query.value(3).toLongLong());
+      if (!entry.formName.isEmpty()) forms.insert(entry.formName, query.value(0).toLongLong());
+   }
+   sortedForms = forms.keys();
+   std::sort(sortedForms.begin(), sortedForms.end());
+
+   if (!query.exec("SELECT slotId, slotName, parentId FROM slotTable")) return false;
+   while (query.next()) {
+      QHash<qint64, ClassEntry>::iterator it = classes.find(query.value(2).toLongLong());
+      if (it != classes.end()) it->slotIds.insert(query.value(1).toString(), query.value(0).toLongLong());
+   }
+
+   if (!query.exec("SELECT slotId, objId FROM slotObjTable")) return false;
+   while (query.next()) {
+      slotTypes[query.value(0).toLongLong()].append(query.value(1).toLongLong());
+   }
+   return true;
+}
+
+QList<InputChecker::Problem> InputChecker::check(const QStringList& fileNames) const
+{
+   // each task writes only its own file's list, so they don't need to lock anything
+   QVector<QList<Problem> > results(fileNames.size());
+   QList<Problem>* out = results.data();
+   QThreadPool pool;
+   for (int i = 0; i < fileNames.size(); i++) {
+      pool.start(new InputCheckTask(this, fileNames[i], out + i));
+   }
+   pool.waitForDone();
+
+   QList<Problem> problems;
+   for (int i = 0; i < results.size(); i++) problems += results[i];
+   return problems;
+}
+
+QList<InputChecker::Problem> InputChecker::checkFile(const QString& fileName) const
+{
+   QList<Problem> problems;
+   QFile file(fileName);
+   if (!file.open(QFile::ReadOnly)) {
+      Problem problem = { UnreadableFile, fileName, 0, 0, 0, QString("unable to read %1").arg(fileName) };
+      problems << problem;
+      return problems;
+   }
+   const QString text = QString::fromUtf8(file.readAll());
+   file.close();
+
+   problems = checkText(text);
+   for (int i = 0; i < problems.size(); i++) problems[i].fileName = fileName;
+   return problems;
+}
+
+QList<InputChecker::Problem> InputChecker::checkText(const QString& text) const
+{
+   QList<Problem> problems;
+   Scanner scanner(text);
+   for (Token token = scanner.next(); token.type != Token::End; token = scanner.next()) {
+      if (token.type == Token::Open) checkForm(scanner, problems);
+   }
+   return problems;
+}
+
+QStringList InputChecker::findInputFiles(const QStringList& paths)
+{
+   QStringList files;
+   const QStringList filters = QStringList() << "*.epp" << "*.edl";
+   for (int i = 0; i < paths.size(); i++) {
+      if (!QFileInfo(paths[i]).isDir()) {
+         files << paths[i];
+         continue;
+      }
+      QDirIterator it(paths[i], filters, QDir::Files, QDirIterator::Subdirectories);
+      while (it.hasNext()) files << it.next();
+   }
+   return files;
+}
+
+QStringList InputChecker::formNames(const QString& prefix) const
+{
+   QStringList names;
+   QStringList::const_iterator it = std::lower_bound(sortedForms.constBegin(), sortedForms.constEnd(), prefix);
+   for (; it != sortedForms.constEnd() && it->startsWith(prefix); ++it) names << *it;
+   return names;
+}
+
+bool InputChecker::formInfo(const QString& formName, FormInfo& info) const
+{
+   QHash<qint64, ClassEntry>::const_iterator it = classes.constFind(forms.value(formName, -1));
+   if (it == classes.constEnd()) return false;
+   info.className = it->name;
+   info.fileName = it->fileName;
+   info.baseClass = className(it->base);
+   return true;
+}
+
+QList<InputChecker::SlotInfo> InputChecker::formSlots(const QString& formName) const
+{
+   QList<SlotInfo> found;
+   QSet<QString> names;       // a class's slot hides any of its bases' with the same name
+   qint64 id = forms.value(formName, -1);
+   for (int depth = 0; id >= 0 && depth < ClassHierarchy::MAX_DEPTH; depth++) {
+      QHash<qint64, ClassEntry>::const_iterator it = classes.constFind(id);
+      if (it == classes.constEnd()) break;
+      QStringList own = it->slotIds.keys();
+      std::sort(own.begin(), own.end());
+      for (int i = 0; i < own.size(); i++) {
+         if (names.contains(own[i])) continue;
+         names.insert(own[i]);
+         SlotInfo slot;
+         slot.name = own[i];
+         slot.owner = it->name;
+         slot.fileName = it->fileName;
+         const QVector<qint64> types = slotTypes.value(it->slotIds.value(own[i]));
+         for (int j = 0; j < types.size(); j++) slot.types << className(types[j]);
+         found << slot;
+      }
+      id = it->base;
+   }
+   return found;
+}
+
+// Follows the forms (and lists) down to the position: the first word in a form is its name, a
+// "slot:" (or a word that isn't a slot's value, as it's being typed) is one of its slots.
+InputChecker::Location InputChecker::locate(const QString& text, const int line, const int column)
+{
+   struct Frame {
+      explicit Frame(const bool l = false) : list(l), tokens(0), last(Token::Open) {}
+      bool list;
+      QString form;
+      int tokens;             // read so far in this form
+      Token::Type last;       // the last of them (a nested form counts as its Close)
+   };
+   QVector<Frame> frames;
+
+   Location location;
+   Scanner scanner(text);
+   for (Token token = scanner.next(); ; token = scanner.next()) {
+      const bool after = (token.type == Token::End || token.line > line || (token.line == line && token.column > column));
+      const bool at = (!after && token.line == line && column <= token.column + token.text.size() &&
+                       (token.type == Token::Word || token.type == Token::Slot));
+      if (after || at) {
+         if (frames.isEmpty() || frames.last().list) return location;
+         const Frame& frame = frames.last();
+         location.line = (at ? token.line : line);
+         location.column = (at ? token.column : column);
+         if (at) location.word = token.text;
+         if (frame.tokens == 0) {
+            location.what = Location::Form;
+            location.form = location.word;
+         }
+         else if ((at && token.type == Token::Slot) || frame.last != Token::Slot) {
+            location.what = Location::Slot;
+            location.form = frame.form;
+         }
+         return location;
+      }
+
+      if (token.type == Token::Open) frames.append(Frame(false));
+      else if (token.type == Token::ListOpen) frames.append(Frame(true));
+      else if (token.type == Token::Close || token.type == Token::ListClose) {
+         if (!frames.isEmpty()) frames.removeLast();
+         if (!frames.isEmpty()) {
+            frames.last().last = Token::Close;
+            frames.last().tokens++;
+         }
+      }
+      else if (!frames.isEmpty()) {
+         Frame& frame = frames.last();
+         if (frame.tokens == 0 && token.type == Token::Word) frame.form = token.text;
+         frame.last = token.type;
+         frame.tokens++;
+      }
+   }
+}
+
+// we have just read the "(", returns the form's class (or -1), and the form name's token
+qint64 InputChecker::checkForm(Scanner& scanner, QList<Problem>& problems, Token* formToken) const
+{
+   Token token = scanner.next();
+   if (formToken) *formToken = token;
+   if (token.type == Token::Close || token.type == Token::End) return -1;
+
+   qint64 classId = -1;
+   QString formName;
+   if (token.type == Token::Word) {
+      formName = token.text;
+      classId = forms.value(formName, -1);
+      if (classId < 0) {
+         Problem problem = { UnknownForm, QString(), token.line, token.column, token.text.size(),
+                             QString("unknown form '%1'").arg(formName) };
+         problems << problem;
+      }
+      token = scanner.next();
+   }
+
+   while (token.type != Token::Close && token.type != Token::End) {
+      if (token.type == Token::Slot) {
+         const QString slotName = token.text;
+         qint64 slotId = -1;
+         if (classId >= 0) {
+            slotId = findSlot(classId, slotName);
+            if (slotId < 0) {
+               Problem problem = { UnknownSlot, QString(), token.line, token.column, token.text.size(),
+                                   QString("form '%1' has no slot '%2'").arg(formName, slotName) };
+               problems << problem;
+            }
+         }
+         token = scanner.next();
+         if (token.type == Token::Close || token.type == Token::End) break;
+         checkValue(scanner, token, slotId, slotName, problems);
+      }
+      // positional arguments, e.g. ( Meters 100 )
+      else checkValue(scanner, token, -1, QString(), problems);
+      token = scanner.next();
+   }
+   return classId;
+}
+
+// checks a slot's value (slotId is -1 for positional arguments, or slots we don't know)
+void InputChecker::checkValue(Scanner& scanner, const Token& token, const qint64 slotId, const QString& slotName,
+                              QList<Problem>& problems) const
+{
+   if (token.type == Token::Open) {
+      Token formToken;
+      const qint64 classId = checkForm(scanner, problems, &formToken);
+      const QVector<qint64> types = slotTypes.value(slotId);
+      if (classId < 0 || types.isEmpty()) return;
+      for (int i = 0; i < types.size(); i++) {
+         if (isA(classId, types[i])) return;
+      }
+      Problem problem = { TypeMismatch, QString(), formToken.line, formToken.column, formToken.text.size(),
+                          QString("slot '%1' expects %2, not %3").arg(slotName, className(types[0]), className(classId)) };
+      problems << problem;
+   }
+   else if (token.type == Token::ListOpen) {
+      // list elements (components and the like) aren't checked against the slot's type, only themselves
+      for (Token item = scanner.next(); item.type != Token::ListClose && item.type != Token::End; item = scanner.next()) {
+         if (item.type == Token::Slot) item = scanner.next();
+         checkValue(scanner, item, -1, QString(), problems);
+      }
+   }
+}
+
+qint64 InputChecker::findSlot(const qint64 classId, const QString& slotName) const
+{
+   qint64 id = classId;
+   for (int depth = 0; id >= 0 && depth < ClassHierarchy::MAX_DEPTH; depth++) {
+      QHash<qint64, ClassEntry>::const_iterator it = classes.constFind(id);
+      if (it == classes.constEnd()) break;
+      const qint64 slotId = it->slotIds.value(slotName, -1);
+      if (slotId >= 0) return slotId;
+      id = it->base;
+   }
+   return -1;
+}
+
+bool InputChecker::isA(const qint64 classId, const qint64 typeId) const
+{
+   qint64 id = classId;
+   for (int depth = 0; id >= 0 && depth < ClassHierarchy::MAX_DEPTH; depth++) {
+      if (id == typeId) return true;
+      QHash<qint64, ClassEntry>::const_iterator it = classes.constFind(id);
+      if (it == classes.constEnd()) break;
+      id = it->base;
+   }
+   return false;
+}
+
+QString InputChecker::className(const qint64 classId) const
+{
+   return classes.value(classId).name;
+}
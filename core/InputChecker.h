@@ -0,0 +1,109 @@
+// checks OpenEaagles input files (.epp/.edl) against a parsed database
+#ifndef INPUTCHECKER_H
+#define INPUTCHECKER_H
+
+#include <QHash>
+#include <QList>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Loads the forms, slots (with their types) and base classes from the database into memory once, then
+// checks each "( FormName slot: value ... )" in the input files against them: unknown forms, slots
+// the form (or any of its base classes) doesn't have, and forms given to a slot that wants some other
+// type.  The index is read only once loaded, so files are checked in parallel on a thread pool.
+// Files aren't run through the preprocessor first; # lines are skipped, and macros aren't expanded.
+class InputChecker
+{
+public:
+   enum Kind { UnknownForm, UnknownSlot, TypeMismatch, UnreadableFile };
+
+   struct Problem {
+      Kind kind;
+      QString fileName;
+      int line;               // from 1 (0 if it's about the whole file)
+      int column;             // from 0, in utf-16 code units (as editors count them)
+      int length;             // of the text it's about
+      QString message;
+   };
+
+   // what the index knows about a form (see formInfo())
+   struct FormInfo {
+      QString className;
+      QString fileName;       // the header declaring the class
+      QString baseClass;      // empty if it has none
+   };
+
+   // a slot of a form, declared by the form's class or one of its bases (see formSlots())
+   struct SlotInfo {
+      QString name;
+      QString owner;          // the class declaring it
+      QString fileName;       // and its header
+      QStringList types;      // the classes it accepts (empty if we don't know of any)
+   };
+
+   // what the text at a position names (see locate())
+   struct Location {
+      enum What { Nothing, Form, Slot };
+      Location() : what(Nothing), line(0), column(0) {}
+      What what;
+      QString form;           // the form name, or the form the slot is in
+      QString word;           // the word at the position (empty if it's between words)
+      int line;               // where the word starts (or the position, between words)
+      int column;
+   };
+
+   InputChecker();
+
+   // reads the class, slot and slot type tables (false if they aren't there)
+   bool load(QSqlDatabase db);
+
+   // checks the files in parallel, returning the problems in file (then line) order
+   QList<Problem> check(const QStringList& fileNames) const;
+   // checks a single file
+   QList<Problem> checkFile(const QString& fileName) const;
+   // checks some text, e.g. an editor's unsaved buffer (the problems have no file name)
+   QList<Problem> checkText(const QString& text) const;
+
+   // For editors (see LanguageServer), answered from the index alone:
+   // form names starting with the prefix, in order
+   QStringList formNames(const QString& prefix = QString()) const;
+   // false if there's no such form
+   bool formInfo(const QString& formName, FormInfo& info) const;
+   // the form's slots, its class's own first (by name), then each base class's (less those hidden)
+   QList<SlotInfo> formSlots(const QString& formName) const;
+   // what is at (or being typed at) the line (from 1) and column (from 0) of the text
+   static Location locate(const QString& text, const int line, const int column);
+
+   // the .epp and .edl files in (or under) each path
+   static QStringList findInputFiles(const QStringList& paths);
+
+private:
+   class Scanner;
+   struct Token;
+   struct ClassEntry {
+      ClassEntry() : base(-1) {}
+      QString name;
+      QString formName;
+      QString fileName;
+      qint64 base;                     // class id, or -1
+      QHash<QString, qint64> slotIds;  // slots declared by this class
+   };
+
+   qint64 checkForm(Scanner& scanner, QList<Problem>& problems, Token* formToken = 0) const;
+   void checkValue(Scanner& scanner, const Token& token, const qint64 slotId, const QString& slotName,
+                   QList<Problem>& problems) const;
+   // the slot, declared by the class or one of its bases (-1 if none)
+   qint64 findSlot(const qint64 classId, const QString& slotName) const;
+   // true if the class is the type, or derives from it
+   bool isA(const qint64 classId, const qint64 typeId) const;
+   QString className(const qint64 classId) const;
+
+   QHash<QString, qint64> forms;       // form name -> class id
+   QStringList sortedForms;            // form names, in order (for prefix lookups)
+   QHash<qint64, ClassEntry> classes;  // class id -> class
+   QHash<qint64, QVector<qint64> > slotTypes;   // slot id -> types (class ids) it accepts
+};
+
+#endif // INPUTCHECKER_H
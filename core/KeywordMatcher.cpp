@@ -0,0 +1,69 @@
+#include "KeywordMatcher.h"
+
+KeywordMatcher::KeywordMatcher(const QStringList& keywords)
+   : numClasses(1), charClass(128, 0), numKeywords(qMin(keywords.size(), 32))
+{
+   for (int k = 0; k < numKeywords; k++) {
+      const QString& keyword = keywords[k];
+      for (int i = 0; i < keyword.size(); i++) {
+         const ushort ch = keyword[i].unicode();
+         if (ch < 128 && charClass[ch] == 0) charClass[ch] = numClasses++;
+      }
+   }
+
+   // the trie (0 in next means no edge yet; the root is state 0, so nothing points back to it)
+   next.fill(0, numClasses);
+   found.fill(0, 1);
+   for (int k = 0; k < numKeywords; k++) {
+      int state = 0;
+      const QString& keyword = keywords[k];
+      for (int i = 0; i < keyword.size(); i++) {
+         const ushort ch = keyword[i].unicode();
+         if (ch >= 128) break;
+         const int c = charClass[ch];
+         if (next[state * numClasses + c] == 0) {
+            next[state * numClasses + c] = found.size();
+            next.resize(next.size() + numClasses);
+            found << 0;
+         }
+         state = next[state * numClasses + c];
+      }
+      found[state] |= (1u << k);
+   }
+
+   // failure links, breadth first, filling in the missing edges as we go (so it becomes a dfa)
+   QVector<int> failure(found.size(), 0);
+   QVector<int> queue;
+   for (int c = 1; c < numClasses; c++) {
+      if (next[c] != 0) queue << next[c];
+   }
+   for (int q = 0; q < queue.size(); q++) {
+      const int state = queue[q];
+      found[state] |= found[failure[state]];
+      for (int c = 1; c < numClasses; c++) {
+         const int child = next[state * numClasses + c];
+         if (child != 0) {
+            failure[child] = next[failure[state] * numClasses + c];
+            queue << child;
+         }
+         else next[state * numClasses + c] = next[failure[state] * numClasses + c];
+      }
+   }
+}
+
+quint32 KeywordMatcher::scan(const QString& text) const
+{
+   quint32 result = 0;
+   int state = 0;
+   const quint8* classes = charClass.constData();
+   const quint16* table = next.constData();
+   const quint32* out = found.constData();
+   const QChar* chars = text.constData();
+   for (int i = 0; i < text.size(); i++) {
+      const ushort ch = chars[i].unicode();
+      // anything not in a keyword takes us back to the start
+      state = table[state * numClasses + (ch < 128 ? classes[ch] : 0)];
+      result |= out[state];
+   }
+   return result;
+}
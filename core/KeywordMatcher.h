@@ -0,0 +1,32 @@
+// finds which of a set of keywords appear in a line, in one pass
+#ifndef KEYWORDMATCHER_H
+#define KEYWORDMATCHER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// An Aho-Corasick automaton over the keywords, turned into a full transition table (over just the
+// characters the keywords use), so scanning is one table lookup per character, whatever the number of
+// keywords.  scan() returns a bit for each keyword found (keyword i is bit i), so the parser can test
+// all of its keywords with a single pass over each line, rather than a contains() per keyword.
+class KeywordMatcher
+{
+public:
+   // at most 32 keywords, ASCII only
+   explicit KeywordMatcher(const QStringList& keywords);
+
+   quint32 scan(const QString& text) const;
+   int size() const;
+
+private:
+   int numClasses;               // distinct keyword characters, plus one for everything else
+   QVector<quint8> charClass;    // ASCII character -> class (0 for characters in no keyword)
+   QVector<quint16> next;        // state * numClasses + class -> state
+   QVector<quint32> found;       // state -> keywords ending there (including through failure links)
+   int numKeywords;
+};
+
+inline int KeywordMatcher::size() const      { return numKeywords; }
+
+#endif // KEYWORDMATCHER_H
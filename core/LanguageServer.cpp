@@ -0,0 +1,305 @@
+#include "LanguageServer.h"
+
+#include <QElapsedTimer>
+#include <QFileDevice>
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <iostream>
+
+namespace {
+// protocol constants
+const int PARSE_ERROR = -32700;
+const int METHOD_NOT_FOUND = -32601;
+const int SEVERITY_ERROR = 1;
+const int SEVERITY_WARNING = 2;
+const int KIND_PROPERTY = 10;
+const int KIND_CLASS = 7;
+const int SYNC_FULL = 1;
+
+// requests taking longer than this are logged
+const qint64 SLOW_MSECS = 10;
+
+QJsonObject position(const int line, const int column)
+{
+   QJsonObject pos;
+   pos["line"] = line;
+   pos["character"] = column;
+   return pos;
+}
+
+// our lines count from 1, the protocol's from 0
+QJsonObject range(const int line, const int column, const int length)
+{
+   QJsonObject r;
+   r["start"] = position(line - 1, column);
+   r["end"] = position(line - 1, column + length);
+   return r;
+}
+
+QJsonObject markdown(const QStringList& lines)
+{
+   QJsonObject content;
+   content["kind"] = QString("markdown");
+   content["value"] = lines.join("  \n");
+   return content;
+}
+}
+
+LanguageServer::LanguageServer(const InputChecker& c)
+   : checker(c), output(0), shutdown(false), exiting(false)
+{
+}
+
+int LanguageServer::run(QIODevice& in, QIODevice& out)
+{
+   output = &out;
+   shutdown = false;
+   exiting = false;
+   QJsonObject message;
+   while (!exiting && read(in, message)) {
+      QElapsedTimer timer;
+      timer.start();
+      handle(message);
+      const qint64 elapsed = timer.elapsed();
+      if (elapsed > SLOW_MSECS) {
+         std::cerr << message.value("method").toString().toStdString() << " took " << elapsed << " ms" << std::endl;
+      }
+   }
+   output = 0;
+   return (shutdown ? 0 : 1);
+}
+
+// each message is a Content-Length header (and maybe others), a blank line, then that many bytes of json
+bool LanguageServer::read(QIODevice& in, QJsonObject& message)
+{
+   for (;;) {
+      int length = -1;
+      for (;;) {
+         const QByteArray header = in.readLine();
+         if (header.isEmpty()) return false;
+         const QByteArray line = header.trimmed();
+         if (line.isEmpty()) break;
+         if (line.toLower().startsWith("content-length:")) length = line.mid(15).trimmed().toInt();
+      }
+      if (length < 0) continue;
+
+      QByteArray body;
+      while (body.size() < length) {
+         const QByteArray part = in.read(length - body.size());
+         if (part.isEmpty()) return false;
+         body += part;
+      }
+
+      QJsonParseError error;
+      const QJsonDocument doc = QJsonDocument::fromJson(body, &error);
+      if (doc.isObject()) {
+         message = doc.object();
+         return true;
+      }
+      respondError(QJsonValue(), PARSE_ERROR, error.errorString());
+   }
+}
+
+void LanguageServer::send(const QJsonObject& message)
+{
+   const QByteArray body = QJsonDocument(message).toJson(QJsonDocument::Compact);
+   output->write("Content-Length: " + QByteArray::number(body.size()) + "\r\n\r\n");
+   output->write(body);
+   // (a file device, so this hands it straight to the client)
+   QFileDevice* file = qobject_cast<QFileDevice*>(output);
+   if (file) file->flush();
+}
+
+void LanguageServer::respond(const QJsonValue& id, const QJsonValue& result)
+{
+   QJsonObject message;
+   message["jsonrpc"] = QString("2.0");
+   message["id"] = id;
+   message["result"] = result;
+   send(message);
+}
+
+void LanguageServer::respondError(const QJsonValue& id, const int code, const QString& text)
+{
+   QJsonObject error;
+   error["code"] = code;
+   error["message"] = text;
+   QJsonObject message;
+   message["jsonrpc"] = QString("2.0");
+   message["id"] = (id.isUndefined() ? QJsonValue() : id);
+   message["error"] = error;
+   send(message);
+}
+
+void LanguageServer::notify(const QString& method, const QJsonObject& params)
+{
+   QJsonObject message;
+   message["jsonrpc"] = QString("2.0");
+   message["method"] = method;
+   message["params"] = params;
+   send(message);
+}
+
+void LanguageServer::handle(const QJsonObject& message)
+{
+   const QString method = message.value("method").toString();
+   const QJsonObject params = message.value("params").toObject();
+   const QJsonValue id = message.value("id");
+   const bool request = !id.isUndefined();
+
+   if (method == "initialize") respond(id, initialize());
+   else if (method == "shutdown") {
+      shutdown = true;
+      respond(id, QJsonValue());
+   }
+   else if (method == "exit") exiting = true;
+   else if (method == "textDocument/didOpen") {
+      const QJsonObject doc = params.value("textDocument").toObject();
+      documents.insert(doc.value("uri").toString(), doc.value("text").toString());
+      publishDiagnostics(doc.value("uri").toString());
+   }
+   else if (method == "textDocument/didChange") {
+      // whole documents, so the last change is all of it
+      const QString uri = params.value("textDocument").toObject().value("uri").toString();
+      const QJsonArray changes = params.value("contentChanges").toArray();
+      if (!changes.isEmpty()) documents.insert(uri, changes.last().toObject().value("text").toString());
+      publishDiagnostics(uri);
+   }
+   else if (method == "textDocument/didClose") {
+      const QString uri = params.value("textDocument").toObject().value("uri").toString();
+      documents.remove(uri);
+      publishDiagnostics(uri);
+   }
+   else if (method == "textDocument/completion") respond(id, completion(params));
+   else if (method == "textDocument/hover") respond(id, hover(params));
+   // anything else we don't do (notifications, such as initialized, need no answer)
+   else if (request) respondError(id, METHOD_NOT_FOUND, "unsupported method " + method);
+}
+
+QJsonValue LanguageServer::initialize() const
+{
+   QJsonObject sync;
+   sync["openClose"] = true;
+   sync["change"] = SYNC_FULL;
+
+   QJsonObject completion;
+   completion["triggerCharacters"] = QJsonArray() << QString("(");
+
+   QJsonObject capabilities;
+   capabilities["textDocumentSync"] = sync;
+   capabilities["completionProvider"] = completion;
+   capabilities["hoverProvider"] = true;
+
+   QJsonObject info;
+   info["name"] = QString("oeSql");
+
+   QJsonObject result;
+   result["capabilities"] = capabilities;
+   result["serverInfo"] = info;
+   return result;
+}
+
+InputChecker::Location LanguageServer::locate(const QJsonObject& params, int& column) const
+{
+   const QString uri = params.value("textDocument").toObject().value("uri").toString();
+   const QJsonObject pos = params.value("position").toObject();
+   column = pos.value("character").toInt();
+   return InputChecker::locate(documents.value(uri), pos.value("line").toInt() + 1, column);
+}
+
+QJsonValue LanguageServer::completion(const QJsonObject& params) const
+{
+   int column = 0;
+   const InputChecker::Location location = locate(params, column);
+   // (just what has been typed of the word so far)
+   const QString prefix = location.word.left(column - location.column);
+
+   QJsonArray items;
+   if (location.what == InputChecker::Location::Form) {
+      const QStringList names = checker.formNames(prefix);
+      for (int i = 0; i < names.size(); i++) {
+         InputChecker::FormInfo info;
+         checker.formInfo(names[i], info);
+         QJsonObject item;
+         item["label"] = names[i];
+         item["kind"] = KIND_CLASS;
+         item["detail"] = info.className;
+         items << item;
+      }
+   }
+   else if (location.what == InputChecker::Location::Slot) {
+      const QList<InputChecker::SlotInfo> slotList = checker.formSlots(location.form);
+      for (int i = 0; i < slotList.size(); i++) {
+         if (!slotList[i].name.startsWith(prefix)) continue;
+         QJsonObject item;
+         item["label"] = slotList[i].name;
+         item["kind"] = KIND_PROPERTY;
+         item["detail"] = (slotList[i].types.isEmpty() ? slotList[i].owner
+                                                       : slotList[i].owner + ": " + slotList[i].types.join(", "));
+         // (nearest class first, as listed)
+         item["sortText"] = QString("%1").arg(i, 5, 10, QChar('0'));
+         items << item;
+      }
+   }
+
+   QJsonObject result;
+   result["isIncomplete"] = false;
+   result["items"] = items;
+   return result;
+}
+
+QJsonValue LanguageServer::hover(const QJsonObject& params) const
+{
+   int column = 0;
+   const InputChecker::Location location = locate(params, column);
+   if (location.word.isEmpty()) return QJsonValue();
+
+   QStringList lines;
+   if (location.what == InputChecker::Location::Form) {
+      InputChecker::FormInfo info;
+      if (!checker.formInfo(location.word, info)) return QJsonValue();
+      lines << QString("**%1** `%2`").arg(location.word, info.className);
+      if (!info.baseClass.isEmpty()) lines << QString("derived from `%1`").arg(info.baseClass);
+      lines << QString("declared in `%1`").arg(info.fileName);
+   }
+   else if (location.what == InputChecker::Location::Slot) {
+      const QList<InputChecker::SlotInfo> slotList = checker.formSlots(location.form);
+      for (int i = 0; i < slotList.size() && lines.isEmpty(); i++) {
+         if (slotList[i].name != location.word) continue;
+         lines << QString("**%1:** slot of `%2`").arg(slotList[i].name, slotList[i].owner);
+         lines << QString("declared in `%1`").arg(slotList[i].fileName);
+         if (!slotList[i].types.isEmpty()) lines << QString("accepts `%1`").arg(slotList[i].types.join("`, `"));
+      }
+   }
+   if (lines.isEmpty()) return QJsonValue();
+
+   QJsonObject result;
+   result["contents"] = markdown(lines);
+   result["range"] = range(location.line, location.column, location.word.size());
+   return result;
+}
+
+// (a closed document has none)
+void LanguageServer::publishDiagnostics(const QString& uri)
+{
+   QJsonArray diagnostics;
+   if (documents.contains(uri)) {
+      const QList<InputChecker::Problem> problems = checker.checkText(documents.value(uri));
+      for (int i = 0; i < problems.size(); i++) {
+         QJsonObject diagnostic;
+         diagnostic["range"] = range(problems[i].line, problems[i].column, problems[i].length);
+         // forms may come from macros we don't expand, so those are only warnings
+         diagnostic["severity"] = (problems[i].kind == InputChecker::UnknownForm ? SEVERITY_WARNING : SEVERITY_ERROR);
+         diagnostic["source"] = QString("oeSql");
+         diagnostic["message"] = problems[i].message;
+         diagnostics << diagnostic;
+      }
+   }
+
+   QJsonObject params;
+   params["uri"] = uri;
+   params["diagnostics"] = diagnostics;
+   notify("textDocument/publishDiagnostics", params);
+}
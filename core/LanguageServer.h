@@ -0,0 +1,57 @@
+// a language server (LSP, over stdio) for OpenEaagles input files
+#ifndef LANGUAGESERVER_H
+#define LANGUAGESERVER_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+#include "InputChecker.h"
+
+QT_FORWARD_DECLARE_CLASS(QIODevice)
+
+// Editors start this on an .epp or .edl file, and ask it what they can type where:
+//    completion  - form names after a "(", and the form's slots (inherited ones too) inside it
+//    hover       - a form's class, base class and header; a slot's declaring class, header and the
+//                  classes it accepts
+//    diagnostics - what InputChecker finds wrong, each time a file is opened or changed
+// Everything is answered from the checker's index (loaded once, up front), never the database, so
+// requests answer in a millisecond or so, whatever the size of the framework (slower ones are logged
+// to stderr).  Documents are synced whole (the files are small), and positions are utf-16 columns,
+// as the protocol has them.
+class LanguageServer
+{
+public:
+   // the checker must be loaded, and outlive us
+   explicit LanguageServer(const InputChecker& checker);
+
+   // serves the requests read from in, writing responses and notifications to out, until the client
+   // says exit (or goes away); returns the exit code the protocol asks for
+   int run(QIODevice& in, QIODevice& out);
+
+private:
+   // reads the next message (false at the end of the input)
+   bool read(QIODevice& in, QJsonObject& message);
+   void send(const QJsonObject& message);
+   void respond(const QJsonValue& id, const QJsonValue& result);
+   void respondError(const QJsonValue& id, const int code, const QString& text);
+   void notify(const QString& method, const QJsonObject& params);
+
+   void handle(const QJsonObject& message);
+   QJsonValue initialize() const;
+   QJsonValue completion(const QJsonObject& params) const;
+   QJsonValue hover(const QJsonObject& params) const;
+   void publishDiagnostics(const QString& uri);
+
+   // what is at the params' textDocument and position, and the position's column
+   InputChecker::Location locate(const QJsonObject& params, int& column) const;
+
+   const InputChecker& checker;
+   QHash<QString, QString> documents;     // the open documents' text, by uri
+   QIODevice* output;
+   bool shutdown;                         // the client asked us to (so exiting is expected)
+   bool exiting;
+};
+
+#endif // LANGUAGESERVER_H
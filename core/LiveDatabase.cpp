@@ -0,0 +1,48 @@
+#include "LiveDatabase.h"
+#include "ConnectionPool.h"
+
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include <iostream>
+
+const char* const LiveDatabase::SCHEMA = "live";
+
+LiveDatabase::LiveDatabase(const QString& dbName, const QString& stagingUri)
+{
+   connName = ConnectionPool::internalConnectionName("live");
+   QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
+   // read only, so we never get in the way of the parser publishing over the database (uri, so we
+   // can attach the staging database)
+   db.setDatabaseName(dbName.isEmpty() ? QString(":memory:") : dbName);
+   db.setConnectOptions(QString("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=%1").arg(ConnectionPool::BUSY_TIMEOUT));
+   if (db.open()) {
+      QSqlQuery query(db);
+      // shared cache readers would otherwise be locked out until the parser commits
+      query.exec("PRAGMA read_uncommitted = 1");
+      if (!query.exec(QString("ATTACH DATABASE '%1' AS %2").arg(stagingUri).arg(SCHEMA))) {
+         std::cout << "UNABLE TO ATTACH STAGING DATABASE: " << query.lastError().text().toStdString() << std::endl;
+         db.close();
+      }
+   }
+}
+
+LiveDatabase::~LiveDatabase()
+{
+   // detaches the staging database with it
+   {
+      QSqlDatabase db = QSqlDatabase::database(connName, false);
+      db.close();
+   }
+   QSqlDatabase::removeDatabase(connName);
+}
+
+bool LiveDatabase::isOpen() const
+{
+   return database().isOpen();
+}
+
+QSqlDatabase LiveDatabase::database() const
+{
+   return QSqlDatabase::database(connName, false);
+}
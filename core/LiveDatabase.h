@@ -0,0 +1,35 @@
+// a parse in progress, attached to a read only connection so it can be queried with sql
+#ifndef LIVEDATABASE_H
+#define LIVEDATABASE_H
+
+#include <QSqlDatabase>
+#include <QString>
+
+// The parser stages everything in a shared cache memory database, in one long transaction (see
+// StagingDatabase).  A LiveDatabase opens its own read only connection to a database, attaches the
+// staging database to it as the schema "live" and reads it uncommitted, so sql can query the parse
+// as it goes (live.class, live.slotTable, live.slotObjTable), and join it with the database's own
+// tables, without anything being copied or committed first.  Queries see whatever the parser has
+// written so far.  Let it go when the parser says the staging database is closing: while attached
+// it keeps the staging database's memory alive, and holds locks the parser's indexing would wait on.
+class LiveDatabase
+{
+public:
+   // dbName is the database to join the parse with (none if empty), stagingUri the staging database
+   LiveDatabase(const QString& dbName, const QString& stagingUri);
+   ~LiveDatabase();
+
+   // false if either database couldn't be opened
+   bool isOpen() const;
+   QSqlDatabase database() const;
+
+   // the schema the staging database is attached as
+   static const char* const SCHEMA;
+
+private:
+   Q_DISABLE_COPY(LiveDatabase)
+
+   QString connName;
+};
+
+#endif // LIVEDATABASE_H
@@ -0,0 +1,149 @@
+#include "MacroRegistry.h"
+
+#include <QFile>
+#include <QRegExp>
+#include <QTextStream>
+
+namespace {
+struct BuiltinMacro {
+   const char* name;
+   MacroRegistry::Action action;
+   int classArg;
+   int formArg;
+};
+
+const BuiltinMacro builtinMacros[] = {
+   { "IMPLEMENT_SUBCLASS",                   MacroRegistry::FormName,  0, 1 },
+   { "IMPLEMENT_PARTIAL_SUBCLASS",           MacroRegistry::FormName,  0, 1 },
+   { "IMPLEMENT_ABSTRACT_SUBCLASS",          MacroRegistry::FormName,  0, 1 },
+   { "IMPLEMENT_EMPTY_SLOTTABLE_SUBCLASS",   MacroRegistry::FormName,  0, 1 },
+   { "BEGIN_SLOTTABLE",                      MacroRegistry::SlotTable, 0, -1 },
+   { "BEGIN_SLOT_MAP",                       MacroRegistry::SlotMap,   0, -1 }
+};
+}
+
+MacroRegistry::MacroRegistry()
+   : implementHandler(FormName, 0, 1)
+{
+   reset();
+}
+
+void MacroRegistry::reset()
+{
+   handlers.clear();
+   const int n = sizeof(builtinMacros) / sizeof(builtinMacros[0]);
+   for (int i = 0; i < n; i++) {
+      const BuiltinMacro& macro = builtinMacros[i];
+      handlers.insert(macro.name, Handler(macro.action, macro.classArg, macro.formArg));
+   }
+   for (QHash<QString, Handler>::const_iterator it = added.constBegin(); it != added.constEnd(); ++it) {
+      handlers.insert(it.key(), it.value());
+   }
+}
+
+void MacroRegistry::add(const QString& macro, const Handler& handler)
+{
+   added.insert(macro, handler);
+   handlers.insert(macro, handler);
+}
+
+int MacroRegistry::load(const QString& fileName, QStringList* errors)
+{
+   QFile file(fileName);
+   if (!file.open(QFile::ReadOnly | QFile::Text)) return -1;
+
+   int added = 0;
+   QTextStream stream(&file);
+   for (int lineNum = 1; !stream.atEnd(); lineNum++) {
+      const QString line = stream.readLine().section('#', 0, 0).trimmed();
+      if (line.isEmpty()) continue;
+
+      const QStringList fields = line.split(QRegExp("\\s+"));
+      const QString action = fields.value(1).toLower();
+      Handler handler;
+      bool ok = true;
+      if (action == "form") handler.action = FormName;
+      else if (action == "slottable") handler.action = SlotTable;
+      else if (action == "slotmap") handler.action = SlotMap;
+      else if (action == "ignore") handler.action = Ignore;
+      else ok = false;
+      if (ok && fields.size() > 2) handler.classArg = fields[2].toInt(&ok);
+      if (ok && fields.size() > 3) handler.formArg = fields[3].toInt(&ok);
+
+      if (!ok || fields.size() > 4 || handler.classArg < 0) {
+         if (errors) *errors << QString("%1:%2: expected \"NAME form|slottable|slotmap|ignore [classArg [formArg]]\"")
+                                .arg(fileName).arg(lineNum);
+         continue;
+      }
+      handlers.insert(fields[0], handler);
+      added++;
+   }
+   return added;
+}
+
+const MacroRegistry::Handler* MacroRegistry::find(const QString& line, QStringList& args) const
+{
+   // the first of our macros (an identifier followed by a "(") anywhere on the line, such as after
+   // a "namespace Foo {" or a "}"; one hash lookup per identifier
+   const int size = line.size();
+   const Handler* handler = 0;
+   int open = -1;
+   bool quoted = false;
+   for (int start = 0; start < size && handler == 0; ) {
+      const QChar ch = line[start];
+      if (ch == '"') quoted = !quoted;
+      if (quoted || !(ch.isLetter() || ch == '_')) {
+         start++;
+         continue;
+      }
+      int end = start;
+      while (end < size && (line[end].isLetterOrNumber() || line[end] == '_')) end++;
+      open = end;
+      while (open < size && line[open].isSpace()) open++;
+      if (open < size && line[open] == '(') {
+         const QString name = line.mid(start, end - start);
+         QHash<QString, Handler>::const_iterator it = handlers.constFind(name);
+         if (it != handlers.constEnd()) handler = &it.value();
+         else if (name.startsWith("IMPLEMENT_")) handler = &implementHandler;
+      }
+      start = end;
+   }
+   if (handler == 0) return 0;
+
+   // the comma separated arguments (commas in quotes don't count), up to the closing )
+   args.clear();
+   QString arg;
+   quoted = false;
+   int depth = 0;
+   for (int i = open + 1; i < size; i++) {
+      const QChar ch = line[i];
+      if (ch == '"') {
+         quoted = !quoted;
+         continue;
+      }
+      if (!quoted) {
+         if (ch == ')' && depth == 0) break;
+         if (ch == ',' && depth == 0) {
+            args << arg.trimmed();
+            arg.clear();
+            continue;
+         }
+         if (ch == '(') depth++;
+         else if (ch == ')') depth--;
+      }
+      arg.append(ch);
+   }
+   args << arg.trimmed();
+   return handler;
+}
+
+QList<QByteArray> MacroRegistry::prefilterPatterns() const
+{
+   QList<QByteArray> patterns;
+   patterns << "IMPLEMENT_" << "BEGIN_SLOT";
+   for (QHash<QString, Handler>::const_iterator it = handlers.constBegin(); it != handlers.constEnd(); ++it) {
+      if (it.key().startsWith("IMPLEMENT_") || it.key().startsWith("BEGIN_SLOT")) continue;
+      patterns << it.key().toLatin1();
+   }
+   return patterns;
+}
@@ -0,0 +1,58 @@
+// the OpenEaagles macros the parser understands, and what each one tells it
+#ifndef MACROREGISTRY_H
+#define MACROREGISTRY_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+// Source lines are dispatched on the first macro in them, by a hash lookup per identifier, so adding
+// macros costs nothing per line.  The built in macros are a compiled in table; projects with macros of their
+// own list them in a file (see load()).  Any other IMPLEMENT_ macro is taken to be the usual
+// IMPLEMENT_xxx(Class, "form", ...) shape.
+class MacroRegistry
+{
+public:
+   enum Action {
+      Ignore,        // a known macro that tells us nothing
+      FormName,      // names the form of a class (classArg, formArg)
+      SlotTable,     // starts the slot names of a class (classArg), up to END_SLOTTABLE
+      SlotMap        // starts the slot types of a class (classArg), up to END_SLOT_MAP
+   };
+
+   struct Handler {
+      Handler() : action(Ignore), classArg(0), formArg(1) {}
+      Handler(const Action a, const int c, const int f) : action(a), classArg(c), formArg(f) {}
+      Action action;
+      int classArg;        // argument holding the class name
+      int formArg;         // argument holding the (quoted) form name
+   };
+
+   // just the built in macros
+   MacroRegistry();
+
+   // back to the built in macros, and any add()ed ones (dropping those load()ed)
+   void reset();
+   // adds (or replaces) a macro, for good
+   void add(const QString& macro, const Handler& handler);
+   // Adds (or replaces) macros from a file, one per line: "NAME action [classArg [formArg]]", where
+   // action is form, slottable, slotmap or ignore, and arguments count from 0 (# starts a comment).
+   // Returns the number added, or -1 if the file can't be read; bad lines are described in errors.
+   int load(const QString& fileName, QStringList* errors = 0);
+
+   // the handler for the first of our macros on the line (0 if there isn't one), and its arguments
+   // (trimmed, with quotes removed)
+   const Handler* find(const QString& line, QStringList& args) const;
+
+   // byte patterns that any source file using one of our macros must contain (for a Prefilter)
+   QList<QByteArray> prefilterPatterns() const;
+
+private:
+   QHash<QString, Handler> handlers;
+   QHash<QString, Handler> added;   // by add(), so kept by reset()
+   Handler implementHandler;        // any other IMPLEMENT_ macro
+};
+
+#endif // MACROREGISTRY_H
@@ -0,0 +1,38 @@
+#include "NameTable.h"
+
+NameTable& NameTable::instance()
+{
+   static NameTable table;
+   return table;
+}
+
+int NameTable::intern(const QString& name)
+{
+   {
+      QReadLocker locker(&lock);
+      QHash<QString, int>::const_iterator it = ids.constFind(name);
+      if (it != ids.constEnd()) return it.value();
+   }
+
+   QWriteLocker locker(&lock);
+   // someone may have beaten us to it
+   QHash<QString, int>::const_iterator it = ids.constFind(name);
+   if (it != ids.constEnd()) return it.value();
+
+   const int id = names.size();
+   names.append(name);
+   ids.insert(name, id);
+   return id;
+}
+
+int NameTable::find(const QString& name) const
+{
+   QReadLocker locker(&lock);
+   return ids.value(name, -1);
+}
+
+QString NameTable::name(const int id) const
+{
+   QReadLocker locker(&lock);
+   return names.value(id);
+}
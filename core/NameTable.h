@@ -0,0 +1,35 @@
+// interned names shared by all of the class/slot tree models
+#ifndef NAMETABLE_H
+#define NAMETABLE_H
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+// Every distinct class, slot and slot type name is stored here exactly once, and the tree
+// models only keep the integer id.  The same class names show up thousands of times across
+// the trees of every open database, so memory now scales with the number of distinct names.
+class NameTable
+{
+public:
+   // the one table shared by everyone
+   static NameTable& instance();
+
+   // returns the id of the name, adding it if we haven't seen it before
+   int intern(const QString& name);
+   // returns the id of the name, or -1 if we have never seen it
+   int find(const QString& name) const;
+   // returns the name for the given id
+   QString name(const int id) const;
+
+private:
+   NameTable() {}
+   Q_DISABLE_COPY(NameTable)
+
+   mutable QReadWriteLock lock;
+   QHash<QString, int> ids;      // name -> id
+   QVector<QString> names;       // id -> name
+};
+
+#endif // NAMETABLE_H
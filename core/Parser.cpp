@@ -1,27 +1,33 @@
 #include "Parser.h"
-#include <QMessageBox>
+#include "SearchIndex.h"
+#include "ClassHierarchy.h"
+#include "ConnectionPool.h"
+#include "StagingDatabase.h"
 #include <QSqlDatabase>
 #include <QString>
 #include <QSqlQuery>
-#include <QApplication>
 #include <QDir>
+#include <QDateTime>
 
 #include <iostream>
 
-int Parser::numClasses = 0;
-int Parser::numSlots = 0;
+const char* const Parser::MACRO_FILE = "oeSqlMacros.txt";
+const qint64 Parser::MAX_ID = Q_INT64_C(0x7fffffffffffffff);
 
-Parser::Parser(QWidget *parent)
-   : QWidget(parent)
+Parser::Parser(QObject *parent)
+   : QObject(parent), canceled(false), numFiles(0), numSkipped(0),
+     // buildClassTable only adds classes declared inside a namespace, and buildSlotTable only
+     // looks at IMPLEMENT_, BEGIN_SLOTTABLE( and BEGIN_SLOT_MAP( lines
+     headerFilter(QList<QByteArray>() << "class" << "namespace", Prefilter::AllPatterns),
+     sourceFilter(QList<QByteArray>() << "IMPLEMENT_" << "BEGIN_SLOT", Prefilter::AnyPattern), filterSources(true),
+     keywords(keywordList())
 {
-   //db = 0;
-
-   if (QSqlDatabase::drivers().isEmpty())
-        QMessageBox::information(this, tr("No database drivers found"),
-                                 tr("This demo requires at least one Qt database driver. "
-                                    "Please check the documentation how to build the "
-                                    "Qt SQL plugins."));
+}
 
+QStringList Parser::keywordList()
+{
+   return QStringList() << "namespace" << "using" << "END_SLOTTABLE(" << "END_SLOT_MAP("
+                        << "class" << ";" << "{" << "}" << ":";
 }
 
 Parser::~Parser()
@@ -29,173 +35,253 @@ Parser::~Parser()
 
 }
 
-void Parser::parse(QString dir, QString dbName)
+// We parse into an in memory staging database, and only when everything has been parsed (and
+// indexed) is it published over the user's database, in one transaction.  Until then, anyone
+// browsing the database keeps seeing the previous version, and cancelling leaves it untouched.
+Parser::Result Parser::parse(QString dir, QString dbName)
 {
-   // make sure there is a database
-   QSqlDatabase db = QSqlDatabase::database(dbName);
-
-   if (db.isOpen()) {
-      databaseName = dbName;
-      bool noTables = (db.tables().count() == 0);
-      QSqlQuery* query = new QSqlQuery(db);
-      if (noTables) {
-         // new tables
-         // Class table
-         // ID: integer
-         // Class name: string
-         // Form name: Factory name (.epp) of the class
-         // File name: originating file name
-         // Baseclass: integer to another object (if this object is derived)
-         query->exec("create table class (id integer, className varchar(50), formName varchar(50), fileName varchar(50), baseClass integer)");
-
-         // new slot table
-         // Slot Table
-         // slotId: integer
-         // slotName: name of the slot
-         // parentId: object id of the class in which this slot belongs to
-         query->exec("create table slotTable (slotId integer primary key, slotName varchar(50), parentId integer)");
-
-         // and the slot to object table
-         // Slot Object Table
-         // objId: id of the object type we are, reference class.id
-         // slotId: id of the slot we are representing, referencing slotTable.slotId
-         query->exec("create table slotObjTable (slotId integer, objId integer)");
-      }
-      else {
-         query->exec("DELETE FROM class");
-         query->exec("DELETE from slotTable");
-         query->exec("DELETE from slotObjTable");
-      }
+   if (!traceFile.isEmpty()) trace.start();
+   Result result;
+   {
+      TraceSpan span(trace, "parse", "phase");
+      span.arg("dir", dir);
+      result = parseInto(dir, dbName);
+      span.arg("files", numFiles);
+      span.arg("skipped", numSkipped);
+   }
+   if (trace.isEnabled()) {
+      trace.stop();
+      if (!trace.write(traceFile)) std::cout << "UNABLE TO WRITE TRACE " << traceFile.toStdString() << std::endl;
+   }
+   return result;
+}
 
+Parser::Result Parser::parseInto(QString dir, QString dbName)
+{
+   canceled = false;
+   numFiles = 0;
+   numSkipped = 0;
+
+   // our own (and our caller's) macros, then any the project has
+   macros.reset();
+   const QString macroFile = QDir(dir).filePath(MACRO_FILE);
+   if (QFile::exists(macroFile)) {
+      QStringList errors;
+      if (macros.load(macroFile, &errors) < 0) std::cout << "UNABLE TO READ " << macroFile.toStdString() << std::endl;
+      for (int i = 0; i < errors.size(); i++) std::cout << errors[i].toStdString() << std::endl;
+   }
+   const QList<QByteArray> patterns = macros.prefilterPatterns();
+   filterSources = (patterns.size() <= 32);
+   if (filterSources) sourceFilter = Prefilter(patterns, Prefilter::AnyPattern);
 
-      // make sure to reset our index number
-      Parser::numClasses = 0;
+   // make sure there is a database
+   QSqlDatabase db = ConnectionPool::instance().writer(dbName);
 
-      QProgressDialog progressDialog(this);
-      progressDialog.autoReset();
-      progressDialog.setModal(true);
-      progressDialog.setWindowTitle("Parsing Classes");
-      progressDialog.setMaximum(0);
-      progressDialog.show();
+   if (db.isOpen()) {
+      StagingDatabase staging;
+      databaseName = staging.connectionName();
+      QSqlDatabase stagingDb = staging.database();
+      QSqlQuery query(stagingDb);
+
+      // new tables
+      // Class table
+      // ID: integer
+      // Class name: string
+      // Form name: Factory name (.epp) of the class
+      // File name: originating file name
+      // Baseclass: integer to another object (if this object is derived)
+      query.exec("create table class (id integer, className varchar(50), formName varchar(50), fileName varchar(50), baseClass integer)");
+
+      // new slot table
+      // Slot Table
+      // slotId: integer
+      // slotName: name of the slot
+      // parentId: object id of the class in which this slot belongs to
+      // slotIndex: place of the slot in its class's slot table (from 0)
+      query.exec("create table slotTable (slotId integer primary key, slotName varchar(50), parentId integer, slotIndex integer)");
+
+      // and the slot to object table
+      // Slot Object Table
+      // objId: id of the object type we are, reference class.id
+      // slotId: id of the slot we are representing, referencing slotTable.slotId
+      query.exec("create table slotObjTable (slotId integer, objId integer)");
+
+      // the class lookups by name are what the parse spends its time on
+      query.exec("create index classNameIdx on class (className)");
+
+      // no ids handed out yet
+      slotIds.clear();
+
+      // one transaction for the whole parse
+      stagingDb.transaction();
+      emit stagingOpened(dbName, staging.databaseUri());
 
       int count = 0;
-
+      emit phaseStarted(tr("Parsing Classes"));
 
       // we have to do this two times.. one for building classes, the other for the baseclasses
-      readDirectoriesForInclude(dir, progressDialog, count, false);
-      readDirectoriesForInclude(dir, progressDialog, count, true);
-
-      if (progressDialog.wasCanceled()) {
-         // clear our database
-         query->exec("DELETE FROM class");
-         query->exec("DELETE from slotTable");
-         query->exec("DELETE from slotObjTable");
-         QMessageBox::information(0, "PARSING STOPPED", "Parsing was cancelled by user");
-         return;
+      {
+         TraceSpan span(trace, "header pass", "phase");
+         readDirectoriesForInclude(dir, count, false);
+      }
+      // (the same headers again, so only the first pass counts them)
+      numFiles = count;
+      count = 0;
+      resolveClassIds(stagingDb);
+      {
+         TraceSpan span(trace, "base resolution", "phase");
+         readDirectoriesForInclude(dir, count, true);
       }
-      progressDialog.close();
 
-      QProgressDialog slotDialog(this);
-      slotDialog.autoReset();
-      slotDialog.setModal(true);
-      slotDialog.setWindowTitle("Parsing Slots");
+      // the staging database simply goes away
+      if (canceled) {
+         emit stagingClosed();
+         return Canceled;
+      }
 
-      slotDialog.setMaximum(0);
-      slotDialog.show();
       count = 0;
+      emit phaseStarted(tr("Parsing Slots"));
 
-      // we have to do this two times.. one for building classes, the other for the baseclasses
-      readDirectoriesForSource(dir, slotDialog, count);
-
+      {
+         TraceSpan span(trace, "source pass", "phase");
+         readDirectoriesForSource(dir, count);
+      }
+      numFiles += count;
+
+      // nobody can be reading the staging database while we commit, build and index it
+      emit stagingClosed();
+      if (canceled) return Canceled;
+      {
+         TraceSpan span(trace, "database commit", "phase");
+         stagingDb.commit();
+      }
 
-      if (slotDialog.wasCanceled()) {
-         // clear our database
-         query->exec("DELETE FROM class");
-         query->exec("DELETE from slotTable");
-         query->exec("DELETE from slotObjTable");
-         QMessageBox::information(this, "PARSING STOPPED", "Parsing was cancelled by user");
-         return;
+      // and finally, materialize the inheritance and index the names for searching
+      {
+         TraceSpan span(trace, "class hierarchy", "phase");
+         ClassHierarchy::build(stagingDb);
+      }
+      {
+         TraceSpan span(trace, "search index", "phase");
+         SearchIndex::build(stagingDb);
       }
-      slotDialog.close();
 
-      QString numParsed = QString("Files parsed: %1").arg(count);
-      QMessageBox::information(this, "PARSING COMPLETE", numParsed);
+      // the slot object table is only ever looked up (and paged through in the browser) by its ids;
+      // built now the table is full, and published with it
+      query.exec("create index if not exists slotObjSlotIdx on slotObjTable (slotId)");
+      query.exec("create index if not exists slotObjObjIdx on slotObjTable (objId)");
+
+      // remember what we parsed, and when
+      // Parse info table
+      // sourceDir: directory we parsed
+      // parseTime: when we finished, in ISO 8601
+      query.exec("create table parseInfo (sourceDir varchar(256), parseTime varchar(32))");
+      query.prepare("insert into parseInfo values(?, ?)");
+      query.addBindValue(dir);
+      query.addBindValue(QDateTime::currentDateTime().toString(Qt::ISODate));
+      query.exec();
+
+      TraceSpan span(trace, "publish", "phase");
+      return (staging.publish(db) ? Parsed : Failed);
    }
-
+   return Failed;
 }
 
 
 // go through and read all the directories, looking for source files to parse
-void Parser::readDirectoriesForSource(QString path, QProgressDialog &progress, int &count)
+void Parser::readDirectoriesForSource(QString path, int &count)
 {
-   if (progress.wasCanceled()) {
+   if (canceled) {
       return;
    }
-   progress.setValue(progress.value() + 5);
-   qApp->processEvents();
+   emit progress(count);
 
    QDir dir(path);
-   QFileInfoList dirs = dir.entryInfoList(QDir::NoDotAndDotDot | QDir::Dirs);
-   QStringList filters;
-   filters << "*.cpp";
-   // First, look for .cpp files to parse
-   QStringList fileList = dir.entryList(filters, QDir::Files);
+   QFileInfoList dirs;
+   QStringList fileList;
+   {
+      TraceSpan span(trace, dir.dirName(), "enumerate");
+      span.arg("path", path);
+      dirs = dir.entryInfoList(QDir::NoDotAndDotDot | QDir::Dirs);
+      QStringList filters;
+      filters << "*.cpp";
+      // First, look for .cpp files to parse
+      fileList = dir.entryList(filters, QDir::Files);
+   }
    QFile file;
    QString finalString;
    // parse the files, and add the contents to the database
-   for (int i = 0; i < fileList.size(); i++) {
-      progress.setValue(progress.value() + 5);
-      qApp->processEvents();
+   for (int i = 0; i < fileList.size() && !canceled; i++) {
+      emit progress(count);
       finalString = dir.absolutePath();
       finalString.append("/");
       finalString.append(fileList[i]);
       file.setFileName(finalString);
       file.open(QFile::ReadOnly);
       count++;
-      buildSlotTable(file);
+      TraceSpan span(trace, fileList[i], "source");
+      span.arg("path", finalString);
+      span.arg("bytes", file.size());
+      if (!filterSources || sourceFilter.matches(file)) buildSlotTable(file);
+      else {
+         numSkipped++;
+         span.arg("skipped", true);
+      }
       file.close();
    }
    for (int i = 0; i < dirs.size(); i++) {
       QString newPath = dirs[i].absoluteFilePath();
-      readDirectoriesForSource(newPath, progress, count);
+      readDirectoriesForSource(newPath, count);
    }
 }
 
 // go through and read all the directories, looking for include files to parse
-void Parser::readDirectoriesForInclude(QString path, QProgressDialog &progress, int& count, bool baseclassPass)
+void Parser::readDirectoriesForInclude(QString path, int& count, bool baseclassPass)
 {
-   if (progress.wasCanceled()) {
+   if (canceled) {
       return;
    }
-   progress.setValue(progress.value() + 5);
-   qApp->processEvents();
+   emit progress(count);
 
    //std::cout << "READING DIRECTORY = " << path.toStdString() << std::endl;
 
    QDir dir(path);
-   QFileInfoList dirs = dir.entryInfoList(QDir::NoDotAndDotDot | QDir::Dirs);
-   QStringList filters;
-   filters << "*.h";
-   // First, look for .cpp files to parse
-   QStringList fileList = dir.entryList(filters, QDir::Files);
+   QFileInfoList dirs;
+   QStringList fileList;
+   {
+      TraceSpan span(trace, dir.dirName(), "enumerate");
+      span.arg("path", path);
+      dirs = dir.entryInfoList(QDir::NoDotAndDotDot | QDir::Dirs);
+      QStringList filters;
+      filters << "*.h";
+      // First, look for .cpp files to parse
+      fileList = dir.entryList(filters, QDir::Files);
+   }
    QFile file;
    QString finalString;
    // parse the files, and add the contents to the database
-   for (int i = 0; i < fileList.size(); i++) {
-      progress.setValue(progress.value() + 5);
-      qApp->processEvents();
+   for (int i = 0; i < fileList.size() && !canceled; i++) {
+      emit progress(count);
       finalString = dir.absolutePath();
       finalString.append("/");
       finalString.append(fileList[i]);
       file.setFileName(finalString);
       file.open(QFile::ReadOnly);
       count++;
-      buildClassTable(file, baseclassPass);
+      TraceSpan span(trace, fileList[i], "header");
+      span.arg("path", finalString);
+      span.arg("bytes", file.size());
+      if (headerFilter.matches(file)) buildClassTable(file, baseclassPass);
+      else {
+         // (once per file, like filesParsed(), not again on the base class pass)
+         if (!baseclassPass) numSkipped++;
+         span.arg("skipped", true);
+      }
       file.close();
    }
    for (int i = 0; i < dirs.size(); i++) {
       QString newPath = dirs[i].absoluteFilePath();
-      readDirectoriesForInclude(newPath, progress, count, baseclassPass);
+      readDirectoriesForInclude(newPath, count, baseclassPass);
    }
 }
 
@@ -225,7 +311,8 @@ void Parser::buildClassTable(QFile &file, const bool baseclassPass)
 
    // we have to validate the file and make sure it has a class definition in it!
    for (int i = 0; i < strings.size() && !classStarted; i++) {
-      if (strings[i].contains("class") && !strings[i].contains(";")) {
+      const quint32 keys = keywords.scan(strings[i]);
+      if ((keys & ClassKey) && !(keys & SemicolonKey)) {
          classStarted = true;
       }
    }
@@ -235,14 +322,16 @@ void Parser::buildClassTable(QFile &file, const bool baseclassPass)
       QString queryString;
       // make sure there is a database
       QSqlDatabase db = QSqlDatabase::database(databaseName);
-      QSqlQuery* query = new QSqlQuery(db);
+      QSqlQuery query(db);
       // for counting braces before the class starts
       int numBraces = 0;
       for (int i = 0; i < strings.size(); i++) {
+         // every keyword on the line, in one pass
+         const quint32 keys = keywords.scan(strings[i]);
          // possible candidate, let's see what happen
-         if (strings[i].contains("namespace")) {
+         if (keys & NamespaceKey) {
             // check to see if it's forward decs in the same line
-            if (!strings[i].contains("}")) {
+            if (!(keys & CloseBraceKey)) {
                hasNameSpace = true;
                // we have to edit the namespace to be in the right format
                strings[i].replace("namespace", "");
@@ -253,10 +342,10 @@ void Parser::buildClassTable(QFile &file, const bool baseclassPass)
             }
          }
          // a function before the class... handle it.
-         else if (hasNameSpace && strings[i].contains("{") && !strings[i].contains("class")) {
+         else if (hasNameSpace && (keys & OpenBraceKey) && !(keys & ClassKey)) {
             numBraces++;
          }
-         else if (hasNameSpace && strings[i].contains("}")) {
+         else if (hasNameSpace && (keys & CloseBraceKey)) {
             if (numBraces > 0) numBraces--;
             else if (!classStarted) {
                // error handling - something went wrong
@@ -269,7 +358,7 @@ void Parser::buildClassTable(QFile &file, const bool baseclassPass)
             }
          }
          // class definition has started
-         else if (hasNameSpace && strings[i].contains("class") && !strings[i].contains(";")) {
+         else if (hasNameSpace && (keys & ClassKey) && !(keys & SemicolonKey)) {
             // at this point you have a string that is either
             // class XXXX : public XXXX {
             // or class XXXX {
@@ -277,7 +366,7 @@ void Parser::buildClassTable(QFile &file, const bool baseclassPass)
             // let's print the class name
             int idx = strings[i].indexOf("class");
             // derived class... let's look at it!
-            if (strings[i].contains(":")) {
+            if (keys & ColonKey) {
                int dIdx = strings[i].indexOf(":");
                // first things first, let's grab the class name
                QString cString = strings[i].left(dIdx);
@@ -318,15 +407,15 @@ void Parser::buildClassTable(QFile &file, const bool baseclassPass)
                      // ok, let's start by seeing if JUST this name exists
                      //std::cout << "TRYING TO FIND EXPLICIT BASECLASS " << dString.toStdString() << " FROM CLASS " << cString.toStdString() << std::endl;
                      bool ok = false;
-                     int val = 0;
+                     qint64 val = 0;
                      //std::cout << "LOOKING FOR " << dString.toStdString() << std::endl;
                      // first step, just query it like it is.
                      queryString = QString("SELECT id from class WHERE className='" + dString + "'");
-                     query->exec(queryString);
-                     ok = query->first();
+                     query.exec(queryString);
+                     ok = query.first();
                      if (ok) {
                         // did we find it?
-                        val = query->value(0).toInt();
+                        val = query.value(0).toLongLong();
                      }
                      else {
                         // it didn't find it as is... let's start with the first explicit namespace, and see if we already have it
@@ -342,11 +431,11 @@ void Parser::buildClassTable(QFile &file, const bool baseclassPass)
                               dString.replace(tString, "");
                               // now just search for it as is again!
                               queryString = QString("SELECT id from class WHERE className='" + dString + "'");
-                              query->exec(queryString);
-                              ok = query->first();
+                              query.exec(queryString);
+                              ok = query.first();
                               if (ok) {
                                  // did we find it?
-                                 val = query->value(0).toInt();
+                                 val = query.value(0).toLongLong();
                               }
                            }
                         }
@@ -359,11 +448,11 @@ void Parser::buildClassTable(QFile &file, const bool baseclassPass)
                               //std::cout << "LOOKING FOR " << (nString + dString).toStdString() << std::endl;
                               // first step, just query it like it is.
                               queryString = QString("SELECT id from class WHERE className='" + nString + dString + "'");
-                              query->exec(queryString);
-                              ok = query->first();
+                              query.exec(queryString);
+                              ok = query.first();
                               if (ok) {
                                  // did we find it?
-                                 val = query->value(0).toInt();
+                                 val = query.value(0).toLongLong();
                               }
                            }
                         }
@@ -373,7 +462,7 @@ void Parser::buildClassTable(QFile &file, const bool baseclassPass)
                         //std::cout << "FOUND BASECLASS!" << std::endl;
                         QString bqString = QString("UPDATE class SET baseclass=%1").arg(val);
                         bqString.append(" WHERE className = '" + cString + "'");
-                        query->exec(bqString);
+                        query.exec(bqString);
                      }
                   }
                   else {
@@ -385,14 +474,14 @@ void Parser::buildClassTable(QFile &file, const bool baseclassPass)
                      //std::cout << "TRYING TO FIND BASECLASS " << dString.toStdString() << " FROM CLASS " << cString.toStdString() << std::endl;
                      // Find our baseclass class in the records
                      queryString = QString("SELECT id from class WHERE className='" + dString + "'");
-                     query->exec(queryString);
-                     if (query->isActive()) {
-                        bool ok = query->first();
+                     query.exec(queryString);
+                     if (query.isActive()) {
+                        bool ok = query.first();
                         if (ok) {
-                           int val = query->value(0).toInt();
+                           qint64 val = query.value(0).toLongLong();
                            QString bqString = QString("UPDATE class SET baseclass=%1").arg(val);
                            bqString.append(" WHERE className = '" + cString + "'");
-                           query->exec(bqString);
+                           query.exec(bqString);
                            //std::cout << "BASECLASS CLASS WAS FOUND at position " << val << std::endl;
                         }
                      }
@@ -401,12 +490,12 @@ void Parser::buildClassTable(QFile &file, const bool baseclassPass)
                else {
                   //std::cout << "ADDING CLASS = " << cString.toStdString() << std::endl;
                   // build the query
-                  // ID - get a new one
-                  int nextRow = getNextClassNum();
+                  // ID - from the name
+                  qint64 nextRow = classIdFor(cString);
                   queryString = QString("insert into class values(%1").arg(nextRow);
                   queryString.append(", '" + cString + "'");
                   queryString.append(", NULL, '" + file.fileName() + "', NULL)");
-                  query->exec(queryString);
+                  query.exec(queryString);
                }
             }
             else if (!baseclassPass) {
@@ -420,12 +509,12 @@ void Parser::buildClassTable(QFile &file, const bool baseclassPass)
                   temp.prepend(namespaces[j]);
                }
                //std::cout << "NON DERIVED CLASS NAME = " << temp.toStdString() << std::endl;
-               // ID - get a new one
-               int nextRow = getNextClassNum();
+               // ID - from the name
+               qint64 nextRow = classIdFor(temp);
                queryString = QString("insert into class values(%1").arg(nextRow);
                queryString.append(", '" + temp + "'");
                queryString.append(", NULL, '" + file.fileName() + "', NULL)");
-               query->exec(queryString);
+               query.exec(queryString);
             }
          }
       }
@@ -451,7 +540,7 @@ void Parser::buildSlotTable(QFile& file)
       // make sure there is a database
       QSqlDatabase db = QSqlDatabase::database(databaseName);
       // Sql stuff
-      QSqlQuery* query = new QSqlQuery(db);
+      QSqlQuery query(db);
       QString queryString;
       // comment stripped string from file
       QList<QString> strings = removeComments(stream);
@@ -460,16 +549,22 @@ void Parser::buildSlotTable(QFile& file)
       // name(s) of the classes we belong to
       QList<QString> classNames;
       // Index maps of that given class (this lines up with classnames)
-      QList< QMap<int, int> > tIdxToSlotId;
+      QList< QMap<int, qint64> > tIdxToSlotId;
 
       // our top level namespaces (so we can make fully qualified names)
       QList<QString> namespaces;
 
+      // the macro on the current line, and its arguments
+      const MacroRegistry::Handler* macro = 0;
+      QStringList args;
+
       // parse our strings
       for (int i = 0; i < strings.size(); i++) {
+         // every keyword on the line, in one pass
+         const quint32 keys = keywords.scan(strings[i]);
          // look for namespaces first, (because they will be).
          // We ignore using namespace commands - this isn't OE design and can be tough to parse (for example, using namespace std)
-         if (strings[i].contains("namespace") && !strings[i].contains("using")) {
+         if ((keys & NamespaceKey) && !(keys & UsingKey)) {
             int idx = strings[i].indexOf("namespace");
             int fIndex = strings[i].indexOf("{");
             idx += 9;
@@ -479,29 +574,28 @@ void Parser::buildSlotTable(QFile& file)
             temp.append("::");
             namespaces.push_front(temp);
          }
-         else if (strings[i].contains("IMPLEMENT_")) {
+         // then it's down to the first of our macros on the line (if any), which may follow the namespace
+         if ((macro = macros.find(strings[i], args)) == 0) {
+            continue;
+         }
+         else if (macro->action == MacroRegistry::FormName) {
             // grab the class name
-            int startJ = strings[i].indexOf("(", 0);
-            int lastJ = strings[i].indexOf(",", 0);
-            QString className = strings[i].mid(startJ+1, (lastJ - startJ)-1);
+            QString className = args.value(macro->classArg);
+            // now the form name
+            QString formName = args.value(macro->formArg);
+            if (className.isEmpty() || formName.isEmpty()) continue;
             for (int x = 0; x < namespaces.size(); x++) {
                // append the namespaces!
                className.prepend(namespaces[x]);
             }
-            // now the form name
-            startJ = strings[i].indexOf("\"", 0);
-            lastJ = strings[i].indexOf("\"", startJ+1) ;
-            QString formName = strings[i].mid(startJ+1, (lastJ - startJ)-1);
             // update the formname for this object
             QString bqString = QString("UPDATE class SET formname='" + formName + "' WHERE className = '" + className + "'");
-            query->exec(bqString);
+            query.exec(bqString);
          }
-         else if (strings[i].contains("BEGIN_SLOTTABLE(")) {
+         else if (macro->action == MacroRegistry::SlotTable) {
             // now let's update the slots
             // we need to find out which class these slots belong to
-            int startIdx = strings[i].indexOf("(", 0);
-            int endIdx = strings[i].indexOf(")", startIdx+1);
-            QString cbt = strings[i].mid(startIdx+1, (endIdx-startIdx) - 1);
+            QString cbt = args.value(macro->classArg);
             // don't add a class name until the slottable is there (which it is!)
             classNames << cbt;
             // fully qualify the class name
@@ -511,32 +605,34 @@ void Parser::buildSlotTable(QFile& file)
             }
 
             // now that we know the class name... let's add the slots.  But first we have to get the class names id.
-            int classId = -1;
+            bool haveClass = false;
+            qint64 classId = 0;
             queryString = "SELECT className, id from class WHERE className='" + cbt + "'";
-            query->exec(queryString);
-            if (query->isActive()) {
-               bool ok = query->first();
-               if (ok) classId = query->value(1).toInt();
+            query.exec(queryString);
+            if (query.isActive() && query.first()) {
+               haveClass = true;
+               classId = query.value(1).toLongLong();
             }
-            if (classId != -1) {
+            if (haveClass) {
                // increment our string
                i++;
                int startIdx = 0;
-               QMap<int, int> tempIdx;
-               while (i < strings.size() && !strings[i].contains("END_SLOTTABLE(")) {
+               bool probed = false;
+               QMap<int, qint64> tempIdx;
+               while (i < strings.size() && !(keywords.scan(strings[i]) & EndSlotTableKey)) {
                   int slotStart = strings[i].indexOf("\"", 0);
                   int slotEnd = strings[i].indexOf("\"", slotStart+1);
                   // there may be multiple slots on a single line, comma delimited
                   while (slotStart != -1 && slotEnd > slotStart) {
                      QString slotName = strings[i].mid(slotStart+1, (slotEnd-slotStart) - 1);
                      //std::cout << "SLOT NAME = " << slotName.toStdString() << std::endl;
-                     int nextSlot = getNextSlotNum();
+                     qint64 nextSlot = newSlotId(cbt, slotName, probed);
                      //std::cout << "SLOT INDEX = " << nextSlot << std::endl;
-                     tempIdx.insert(startIdx++, nextSlot);
                      queryString = QString("insert into slotTable values(%1").arg(nextSlot);
-                     QString other = QString(", '" + slotName + "', " + "%1)").arg(classId);
+                     QString other = QString(", '" + slotName + "', " + "%1, %2)").arg(classId).arg(startIdx);
+                     tempIdx.insert(startIdx++, nextSlot);
                      queryString += other;
-                     query->exec(queryString);
+                     query.exec(queryString);
                      slotStart = strings[i].indexOf("\"", slotEnd+1);
                      slotEnd  = strings[i].indexOf("\"", slotStart+1);
                   }
@@ -544,14 +640,16 @@ void Parser::buildSlotTable(QFile& file)
                   i++;
                }
                tIdxToSlotId << tempIdx;
+               if (probed) {
+                  std::cout << "SLOT IDS FOR " << cbt.toStdString() << " ALREADY TAKEN (A SECOND SLOT TABLE?) IN "
+                            << file.fileName().toStdString() << ", USING THE NEXT FREE IDS" << std::endl;
+               }
             }
          }
          // now it's time for slot index mapping to the objects they will accept
-         else if (strings[i].contains("BEGIN_SLOT_MAP(")) {
+         else if (macro->action == MacroRegistry::SlotMap) {
             // find the name of the class in which we are beginning the map for
-            int startIdx = strings[i].indexOf("(", 0);
-            int endIdx = strings[i].indexOf(")", startIdx+1);
-            QString cbt = strings[i].mid(startIdx+1, (endIdx-startIdx) - 1);
+            QString cbt = args.value(macro->classArg);
             // find the position in the list in which this guy is
             bool found = false;
             int idxPos = -1;
@@ -564,7 +662,7 @@ void Parser::buildSlotTable(QFile& file)
 
             // increment to the next string
             i++;
-            while (i < strings.size() && !strings[i].contains("END_SLOT_MAP(")) {
+            while (i < strings.size() && !(keywords.scan(strings[i]) & EndSlotMapKey)) {
                strings[i].replace(" ", "");
                // remove any whitespace
                int slotStart = strings[i].indexOf("(", 0);
@@ -586,7 +684,7 @@ void Parser::buildSlotTable(QFile& file)
 
                   // map this to the actual position in the table
                   if (slotId > 0 && idxPos != -1) {
-                     int actSlotId = tIdxToSlotId[idxPos].value(slotId-1);
+                     qint64 actSlotId = tIdxToSlotId[idxPos].value(slotId-1);
                      // now let's find the object type.
                      slotStart = strings[i].indexOf(",", slotEnd+1);
                      slotEnd = strings[i].indexOf(")", slotStart+1);
@@ -595,15 +693,15 @@ void Parser::buildSlotTable(QFile& file)
                      if (objTypeName.contains("::")) {
                         // ok, let's start by seeing if JUST this name exists
                         bool ok = false;
-                        int val = 0;
+                        qint64 val = 0;
                         //std::cout << "LOOKING FOR " << objTypeName.toStdString() << std::endl;
                         // first step, just query it like it is.
                         queryString = QString("SELECT id from class WHERE className='" + objTypeName + "'");
-                        query->exec(queryString);
-                        ok = query->first();
+                        query.exec(queryString);
+                        ok = query.first();
                         if (ok) {
                            // did we find it?
-                           val = query->value(0).toInt();
+                           val = query.value(0).toLongLong();
                         }
                         else {
                            // it didn't find it as is... let's start with the first explicit namespace
@@ -626,11 +724,11 @@ void Parser::buildSlotTable(QFile& file)
                                  //std::cout << "LOOKING FOR " << (nString + dString).toStobjTypeName() << std::endl;
                                  // first step, just query it like it is.
                                  queryString = QString("SELECT id from class WHERE className='" + nString + objTypeName + "'");
-                                 query->exec(queryString);
-                                 ok = query->first();
+                                 query.exec(queryString);
+                                 ok = query.first();
                                  if (ok) {
                                     // did we find it?
-                                    val = query->value(0).toInt();
+                                    val = query.value(0).toLongLong();
                                  }
                               }
                            }
@@ -640,7 +738,7 @@ void Parser::buildSlotTable(QFile& file)
                            queryString = QString("insert into slotObjTable values(%1").arg(actSlotId);
                            QString anotherString = QString(", %1)").arg(val);
                            queryString.append(anotherString);
-                           query->exec(queryString);
+                           query.exec(queryString);
                         }
                      }
                      else {
@@ -649,16 +747,16 @@ void Parser::buildSlotTable(QFile& file)
                            objTypeName.prepend(namespaces[x]);
                         }
                         queryString = QString("SELECT id from class WHERE className='" + objTypeName + "'");
-                        query->exec(queryString);
-                        bool ok = query->first();
-                        int val = 0;
+                        query.exec(queryString);
+                        bool ok = query.first();
+                        qint64 val = 0;
                         if (ok) {
                            // did we find it?
-                           val = query->value(0).toInt();
+                           val = query.value(0).toLongLong();
                            queryString = QString("insert into slotObjTable values(%1").arg(actSlotId);
                            QString anotherString = QString(", %1)").arg(val);
                            queryString.append(anotherString);
-                           query->exec(queryString);
+                           query.exec(queryString);
                         }
 
                      }
@@ -674,6 +772,73 @@ void Parser::buildSlotTable(QFile& file)
 
 }
 
+// FNV-1a of the utf-8 name, less its top bit
+qint64 Parser::hashId(const QString& name)
+{
+   const QByteArray bytes = name.toUtf8();
+   quint64 hash = Q_UINT64_C(14695981039346656037);
+   for (int i = 0; i < bytes.size(); i++) {
+      hash ^= static_cast<quint8>(bytes[i]);
+      hash *= Q_UINT64_C(1099511628211);
+   }
+   return static_cast<qint64>(hash & static_cast<quint64>(MAX_ID));
+}
+
+// done once the header pass has added every class, so which class keeps a shared id (and which
+// ids the others move on to) doesn't depend on the order the headers were read in
+void Parser::resolveClassIds(QSqlDatabase db)
+{
+   QSqlQuery query(db);
+   query.setForwardOnly(true);
+   QSet<qint64> taken;
+   QList<qint64> shared;
+   query.exec("SELECT id, COUNT(*) FROM class GROUP BY id ORDER BY id");
+   while (query.next()) {
+      taken.insert(query.value(0).toLongLong());
+      if (query.value(1).toInt() > 1) shared << query.value(0).toLongLong();
+   }
+
+   QSqlQuery update(db);
+   update.prepare("UPDATE class SET id = ? WHERE rowid = ?");
+   for (int i = 0; i < shared.size(); i++) {
+      QList<qint64> rows;
+      QStringList names;
+      query.prepare("SELECT rowid, className, fileName FROM class WHERE id = ? ORDER BY className, fileName");
+      query.addBindValue(shared[i]);
+      query.exec();
+      // the first keeps the id
+      query.next();
+      while (query.next()) {
+         rows << query.value(0).toLongLong();
+         names << query.value(1).toString() + " (" + query.value(2).toString() + ")";
+      }
+      for (int j = 0; j < rows.size(); j++) {
+         qint64 id = shared[i];
+         while (taken.contains(id)) {
+            id = (id == MAX_ID ? 0 : id + 1);
+         }
+         taken.insert(id);
+         update.addBindValue(id);
+         update.addBindValue(rows[j]);
+         update.exec();
+         std::cout << "CLASS ID OF " << names[j].toStdString() << " ALREADY TAKEN, USING " << id << std::endl;
+      }
+   }
+}
+
+// the slot's id, unless something already has it (a second slot table for the class, or a hash
+// collision), in which case it's the next free id after it
+qint64 Parser::newSlotId(const QString& className, const QString& slotName, bool& probed)
+{
+   qint64 id = slotIdFor(className, slotName);
+   if (slotIds.contains(id)) probed = true;
+   while (slotIds.contains(id)) {
+      id = (id == MAX_ID ? 0 : id + 1);
+   }
+   slotIds.insert(id);
+   return id;
+}
+
 // checks the string for any comment lines, and if the line is ALL comments, return true.
 // If there is any valid information in it.. the information is extracted in the string
 QList<QString> Parser::removeComments(QTextStream& stream)
@@ -0,0 +1,118 @@
+// top level parser that does all the parsing and putting of data in the database
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QSet>
+#include <QFile>
+#include <QTextStream>
+#include <QSqlDatabase>
+
+#include "KeywordMatcher.h"
+#include "MacroRegistry.h"
+#include "Prefilter.h"
+#include "TraceLog.h"
+
+// The parser only needs QtCore and QtSql.  Anything showing progress (or letting the user cancel)
+// listens to progress() and calls cancel(); both happen on the thread running parse().
+class Parser : public QObject
+{
+   Q_OBJECT
+public:
+   enum Result { Parsed, Canceled, Failed };
+
+   explicit Parser(QObject* parent = 0);
+   ~Parser();
+
+   // parse and create a database from the dir into the dbName
+   virtual Result parse(QString dir, QString dbName);
+
+   // number of distinct files read by the last parse (headers are read twice, but count once)
+   int filesParsed() const;
+   // how many of those the prefilter found nothing in (so were never parsed)
+   int filesSkipped() const;
+
+   // the keywords the parser looks for in each line, in KeywordMatcher bit order (macros are
+   // looked up in the MacroRegistry instead)
+   enum Keyword {
+      NamespaceKey = 1 << 0, UsingKey = 1 << 1, EndSlotTableKey = 1 << 2, EndSlotMapKey = 1 << 3,
+      ClassKey = 1 << 4, SemicolonKey = 1 << 5, OpenBraceKey = 1 << 6, CloseBraceKey = 1 << 7, ColonKey = 1 << 8
+   };
+   static QStringList keywordList();
+
+   // the macros we understand; each parse starts from the built in ones and any add()ed here,
+   // then loads any listed in the source directory's MACRO_FILE
+   MacroRegistry& macroRegistry();
+   static const char* const MACRO_FILE;
+
+   // if set, each parse writes a trace of its phases, directories and files (Chrome trace event json)
+   void setTraceFile(const QString& fileName);
+
+public slots:
+   // stops the parse before the next file, leaving the database as it was
+   void cancel();
+
+signals:
+   // a new phase of the parse has started ("Parsing Classes", "Parsing Slots")
+   void phaseStarted(const QString& phase);
+   // called as each directory and file is read, with the number of files read so far in the phase
+   void progress(const int files);
+   // The staging database (for dbName) has its tables, and stays open for the parser's file passes;
+   // a LiveDatabase on stagingUri can query it as it fills.  Anything attached to it has to be let
+   // go by stagingClosed(), when the parser finishes with the files (or is cancelled).
+   void stagingOpened(const QString& dbName, const QString& stagingUri);
+   void stagingClosed();
+
+private:
+   Result parseInto(QString dir, QString dbName);
+   void readDirectoriesForSource(QString path, int& count);
+   void readDirectoriesForInclude(QString path, int& count, bool baseclassPass);
+   void buildSlotTable(QFile &file);
+   void buildClassTable(QFile &file, const bool baseclassPass);
+
+   // checks and removes unecessary comments in the stream, returning each
+   // line that isn't empty (with comments removed)
+   QList<QString> removeComments(QTextStream& stream);
+
+   // Ids come from what they name, not the order the files are found in, so adding a file doesn't
+   // renumber the rest, and the same class (or slot) has the same id in every database.  A class's
+   // is a hash of its qualified name, and a slot's a hash of its class's qualified name and its own
+   // (slotTable.slotIndex keeps the slots in the order they are declared).
+   static qint64 hashId(const QString& name);
+   static qint64 classIdFor(const QString& className);
+   static qint64 slotIdFor(const QString& className, const QString& slotName);
+   // moves classes sharing an id (a class declared twice, or a hash collision) on to the next free
+   // ids, in name then file order, so the same headers always give the same ids
+   void resolveClassIds(QSqlDatabase db);
+   // slotIdFor() the slot, or the next free id if that is taken (setting probed)
+   qint64 newSlotId(const QString& className, const QString& slotName, bool& probed);
+
+   static const qint64 MAX_ID;   // ids are never negative (readers use -1 for none)
+
+   QSet<qint64> slotIds;      // slot ids handed out by this parse
+   QString databaseName;      // (staging) database connection we are parsing into
+   bool canceled;             // cancel() was called during this parse
+   int numFiles;              // files read by the last parse
+   int numSkipped;            // files the prefilters ruled out
+
+   Prefilter headerFilter;    // headers with a class definition (in a namespace)
+   Prefilter sourceFilter;    // sources with IMPLEMENT_, slot tables or one of our custom macros
+   bool filterSources;        // false if there are too many custom macros to prefilter for
+   KeywordMatcher keywords;   // all of our keywords, see Keyword
+   MacroRegistry macros;
+
+   QString traceFile;         // where to write the trace (none if empty)
+   TraceLog trace;
+};
+
+inline int Parser::filesParsed() const       { return numFiles; }
+inline int Parser::filesSkipped() const      { return numSkipped; }
+inline MacroRegistry& Parser::macroRegistry()    { return macros; }
+inline void Parser::setTraceFile(const QString& fileName)   { traceFile = fileName; }
+inline void Parser::cancel()                 { canceled = true; }
+inline qint64 Parser::classIdFor(const QString& className)   { return hashId(className); }
+inline qint64 Parser::slotIdFor(const QString& className, const QString& slotName)   { return hashId(className + "::" + slotName); }
+
+#endif // PARSER_H
@@ -0,0 +1,51 @@
+#include "Prefilter.h"
+
+#include <QFile>
+
+#include <cstring>
+
+Prefilter::Prefilter(const QList<QByteArray>& p, const Mode m)
+   : patterns(p), mode(m), allMask(0), firstBytes(256, 0)
+{
+   for (int i = 0; i < patterns.size() && i < 32; i++) {
+      if (patterns[i].isEmpty()) continue;
+      firstBytes[uchar(patterns[i][0])] |= (1u << i);
+      allMask |= (1u << i);
+   }
+}
+
+bool Prefilter::matches(const char* data, const qint64 size) const
+{
+   quint32 found = 0;
+   const quint32* table = firstBytes.constData();
+   for (qint64 pos = 0; pos < size; pos++) {
+      quint32 candidates = table[uchar(data[pos])] & ~found;
+      while (candidates) {
+         int i = 0;
+         while (!(candidates & (1u << i))) i++;
+         candidates &= ~(1u << i);
+         const QByteArray& pattern = patterns[i];
+         if (pattern.size() <= size - pos && std::memcmp(data + pos, pattern.constData(), pattern.size()) == 0) {
+            if (mode == AnyPattern) return true;
+            found |= (1u << i);
+            if (found == allMask) return true;
+         }
+      }
+   }
+   return false;
+}
+
+bool Prefilter::matches(QFile& file) const
+{
+   const qint64 size = file.size();
+   if (size <= 0) return false;
+   uchar* data = file.map(0, size);
+   if (data) {
+      const bool match = matches(reinterpret_cast<const char*>(data), size);
+      file.unmap(data);
+      return match;
+   }
+   const QByteArray bytes = file.readAll();
+   file.seek(0);
+   return matches(bytes.constData(), bytes.size());
+}
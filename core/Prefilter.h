@@ -0,0 +1,35 @@
+// decides from a file's raw bytes whether it can hold anything the parser wants
+#ifndef PREFILTER_H
+#define PREFILTER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QVector>
+
+QT_FORWARD_DECLARE_CLASS(QFile)
+
+// Most files in a source tree have nothing for us, and decoding, line splitting and comment stripping
+// them to find that out is most of the cost.  A prefilter looks for its patterns in the undecoded bytes
+// in one pass (a table of each pattern's first byte, so most bytes are a single lookup), and only
+// files that match go on to the parser.  Matching comments and strings too is fine - it just lets the
+// odd file through that the parser then ignores.
+class Prefilter
+{
+public:
+   enum Mode { AnyPattern, AllPatterns };
+
+   // at most 32 patterns
+   Prefilter(const QList<QByteArray>& patterns, const Mode mode);
+
+   bool matches(const char* data, const qint64 size) const;
+   // maps the (open) file, rather than reading it, when it can
+   bool matches(QFile& file) const;
+
+private:
+   QList<QByteArray> patterns;
+   Mode mode;
+   quint32 allMask;                 // a bit for each pattern
+   QVector<quint32> firstBytes;     // byte -> patterns starting with it
+};
+
+#endif // PREFILTER_H
@@ -0,0 +1,129 @@
+#include "SearchIndex.h"
+
+#include <QSqlQuery>
+#include <QVariant>
+
+bool SearchIndex::build(QSqlDatabase db)
+{
+   clear(db);
+
+   QSqlQuery query(db);
+   // Search term table
+   // termId: integer
+   // term: distinct class, form or slot name
+   query.exec("create table searchTerm (termId integer primary key, term varchar(50))");
+   // Search trigram table
+   // trigram: three (lower case) characters of the padded term
+   // termId: term it belongs to, referencing searchTerm.termId
+   query.exec("create table searchTrigram (trigram char(3), termId integer)");
+
+   db.transaction();
+   query.exec("insert into searchTerm (term) "
+              "SELECT className FROM class WHERE className IS NOT NULL "
+              "UNION SELECT formName FROM class WHERE formName IS NOT NULL "
+              "UNION SELECT slotName FROM slotTable WHERE slotName IS NOT NULL");
+
+   QSqlQuery terms(db);
+   terms.setForwardOnly(true);
+   terms.exec("SELECT termId, term FROM searchTerm");
+   QSqlQuery insert(db);
+   insert.prepare("insert into searchTrigram values(?, ?)");
+   while (terms.next()) {
+      const int termId = terms.value(0).toInt();
+      const QStringList grams = trigrams(terms.value(1).toString(), true);
+      for (int i = 0; i < grams.size(); i++) {
+         insert.bindValue(0, grams[i]);
+         insert.bindValue(1, termId);
+         insert.exec();
+      }
+   }
+
+   query.exec("create index searchTrigramIdx on searchTrigram (trigram, termId)");
+   // so we can go from a name back to the classes and slots quickly
+   query.exec("create index if not exists classNameIdx on class (className)");
+   query.exec("create index if not exists formNameIdx on class (formName)");
+   query.exec("create index if not exists slotNameIdx on slotTable (slotName)");
+   return db.commit();
+}
+
+void SearchIndex::clear(QSqlDatabase db)
+{
+   QSqlQuery query(db);
+   query.exec("DROP TABLE IF EXISTS searchTrigram");
+   query.exec("DROP TABLE IF EXISTS searchTerm");
+}
+
+bool SearchIndex::exists(QSqlDatabase db)
+{
+   return db.tables().contains("searchTrigram");
+}
+
+QList<SearchIndex::Match> SearchIndex::search(QSqlDatabase db, const QString& text, const int maxMatches)
+{
+   QList<Match> matches;
+   const QStringList grams = trigrams(text.trimmed(), false);
+   if (grams.isEmpty()) return matches;
+
+   // rank the names by the number of trigrams they share with the text, shortest first on a tie,
+   // and ignore anything that shares less than half of them
+   QString placeholders = "?";
+   for (int i = 1; i < grams.size(); i++) placeholders.append(", ?");
+   QSqlQuery query(db);
+   query.setForwardOnly(true);
+   query.prepare("SELECT searchTerm.term, COUNT(*) AS hits FROM searchTrigram "
+                 "JOIN searchTerm ON searchTerm.termId = searchTrigram.termId "
+                 "WHERE searchTrigram.trigram IN (" + placeholders + ") "
+                 "GROUP BY searchTrigram.termId HAVING hits >= ? "
+                 "ORDER BY hits DESC, length(searchTerm.term) LIMIT ?");
+   for (int i = 0; i < grams.size(); i++) query.addBindValue(grams[i]);
+   query.addBindValue((grams.size() + 1) / 2);
+   query.addBindValue(maxMatches);
+   query.exec();
+
+   // now expand the names into what uses them
+   QSqlQuery classQuery(db);
+   classQuery.setForwardOnly(true);
+   classQuery.prepare("SELECT id, className FROM class WHERE className = ?");
+   QSqlQuery formQuery(db);
+   formQuery.setForwardOnly(true);
+   formQuery.prepare("SELECT id, className FROM class WHERE formName = ?");
+   QSqlQuery slotQuery(db);
+   slotQuery.setForwardOnly(true);
+   slotQuery.prepare("SELECT slotTable.slotId, class.className FROM slotTable "
+                     "LEFT JOIN class ON class.id = slotTable.parentId WHERE slotTable.slotName = ?");
+
+   QSqlQuery* lookups[3] = { &classQuery, &formQuery, &slotQuery };
+   const Kind kinds[3] = { ClassName, FormName, SlotName };
+   while (query.next() && matches.size() < maxMatches) {
+      const QString term = query.value(0).toString();
+      for (int k = 0; k < 3 && matches.size() < maxMatches; k++) {
+         lookups[k]->bindValue(0, term);
+         lookups[k]->exec();
+         while (lookups[k]->next() && matches.size() < maxMatches) {
+            Match match;
+            match.kind = kinds[k];
+            match.id = lookups[k]->value(0).toLongLong();
+            match.name = term;
+            if (kinds[k] != ClassName) match.owner = lookups[k]->value(1).toString();
+            matches << match;
+         }
+      }
+   }
+   return matches;
+}
+
+// the distinct trigrams of the lower cased term, padded with two leading spaces (so prefixes
+// match), and a trailing one when indexing
+QStringList SearchIndex::trigrams(const QString& term, const bool padEnd)
+{
+   QStringList grams;
+   if (term.isEmpty()) return grams;
+
+   QString padded = "  " + term.toLower();
+   if (padEnd) padded.append(" ");
+   for (int i = 0; i + 3 <= padded.size(); i++) {
+      grams << padded.mid(i, 3);
+   }
+   grams.removeDuplicates();
+   return grams;
+}
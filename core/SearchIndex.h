@@ -0,0 +1,40 @@
+// trigram search index over class names, form names and slot names
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QList>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+// The index is built into the database at parse time.  Every distinct class, form and slot name is
+// stored once (searchTerm), along with its trigrams (searchTrigram).  A search ranks the names by
+// how many trigrams they share with the text, and then expands them into the classes and slots
+// that use them.  Names are padded at the front, so that prefix matches rank first while typing.
+class SearchIndex
+{
+public:
+   enum Kind { ClassName, FormName, SlotName };
+
+   struct Match {
+      Kind kind;
+      qint64 id;        // class.id for classes and form names, slotTable.slotId for slots
+      QString name;     // the class, form or slot name that matched
+      QString owner;    // class name the form name or slot belongs to
+   };
+
+   // (re)builds the index from the class and slot tables
+   static bool build(QSqlDatabase db);
+   // removes the index
+   static void clear(QSqlDatabase db);
+   // true if the database has an index
+   static bool exists(QSqlDatabase db);
+
+   // returns the best matches for the text, best first
+   static QList<Match> search(QSqlDatabase db, const QString& text, const int maxMatches = 50);
+
+private:
+   static QStringList trigrams(const QString& term, const bool padEnd);
+};
+
+#endif // SEARCHINDEX_H
@@ -0,0 +1,95 @@
+#include "StagingDatabase.h"
+#include "ConnectionPool.h"
+
+#include <QList>
+#include <QPair>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QVariant>
+
+#include <iostream>
+
+StagingDatabase::StagingDatabase()
+{
+   connName = ConnectionPool::internalConnectionName("staging");
+   QString memName = connName;
+   memName.replace(":", "_");
+   uri = QString("file:%1?mode=memory&cache=shared").arg(memName);
+
+   QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
+   db.setDatabaseName(uri);
+   db.setConnectOptions("QSQLITE_OPEN_URI");
+   if (db.open()) {
+      // bulk loading, nothing to protect here
+      QSqlQuery query(db);
+      query.exec("PRAGMA journal_mode=OFF");
+      query.exec("PRAGMA synchronous=OFF");
+      query.exec("PRAGMA temp_store=MEMORY");
+   }
+}
+
+StagingDatabase::~StagingDatabase()
+{
+   // the memory database goes away with its last connection
+   {
+      QSqlDatabase db = QSqlDatabase::database(connName, false);
+      db.close();
+   }
+   QSqlDatabase::removeDatabase(connName);
+}
+
+QSqlDatabase StagingDatabase::database() const
+{
+   return QSqlDatabase::database(connName, false);
+}
+
+bool StagingDatabase::publish(QSqlDatabase target)
+{
+   QSqlQuery query(target);
+   if (!query.exec(QString("ATTACH DATABASE '%1' AS staging").arg(uri))) {
+      std::cout << "UNABLE TO ATTACH STAGING DATABASE: " << query.lastError().text().toStdString() << std::endl;
+      return false;
+   }
+
+   // everything we built, by type
+   QList< QPair<QString, QString> > tables;
+   QList< QPair<QString, QString> > indexes;
+   QList< QPair<QString, QString> > views;
+   query.exec("SELECT type, name, sql FROM staging.sqlite_master WHERE sql IS NOT NULL");
+   while (query.next()) {
+      const QString type = query.value(0).toString();
+      const QPair<QString, QString> object = qMakePair(query.value(1).toString(), query.value(2).toString());
+      if (type == "table") tables << object;
+      else if (type == "index") indexes << object;
+      else if (type == "view") views << object;
+   }
+
+   bool ok = target.transaction();
+   // views first, as they depend on the tables (dropping a table drops its indexes)
+   for (int i = 0; i < views.size() && ok; i++) {
+      ok = query.exec("DROP VIEW IF EXISTS main.\"" + views[i].first + "\"");
+   }
+   for (int i = 0; i < tables.size() && ok; i++) {
+      ok = query.exec("DROP TABLE IF EXISTS main.\"" + tables[i].first + "\"");
+   }
+   // create and fill the tables, then index them (quicker than filling indexed tables)
+   for (int i = 0; i < tables.size() && ok; i++) {
+      ok = query.exec(tables[i].second) &&
+           query.exec("INSERT INTO main.\"" + tables[i].first + "\" SELECT * FROM staging.\"" + tables[i].first + "\"");
+   }
+   for (int i = 0; i < indexes.size() && ok; i++) {
+      ok = query.exec(indexes[i].second);
+   }
+   for (int i = 0; i < views.size() && ok; i++) {
+      ok = query.exec(views[i].second);
+   }
+
+   if (ok) ok = target.commit();
+   else {
+      std::cout << "UNABLE TO PUBLISH STAGING DATABASE: " << query.lastError().text().toStdString() << std::endl;
+      target.rollback();
+   }
+   query.exec("DETACH DATABASE staging");
+   return ok;
+}
@@ -0,0 +1,39 @@
+// an in memory database to parse into, published to the real one when done
+#ifndef STAGINGDATABASE_H
+#define STAGINGDATABASE_H
+
+#include <QSqlDatabase>
+#include <QString>
+
+// The parser builds into one of these rather than the user's database, so nobody browsing sees
+// half built tables, and writes don't pay for syncing to disk.  When the parse succeeds, publish()
+// copies every table, index and view over the user's in a single transaction on its write connection
+// (WAL readers keep seeing the previous version until it commits).  A cancelled parse just lets the
+// staging database go, leaving the user's untouched.
+class StagingDatabase
+{
+public:
+   StagingDatabase();
+   ~StagingDatabase();
+
+   // connection name and database of the (open) staging database
+   QString connectionName() const;
+   QSqlDatabase database() const;
+   // uri other connections can attach it by (see LiveDatabase)
+   QString databaseUri() const;
+
+   // replaces our tables in the target with the staged ones, returns false (leaving the target as
+   // it was) on any error
+   bool publish(QSqlDatabase target);
+
+private:
+   Q_DISABLE_COPY(StagingDatabase)
+
+   QString connName;
+   QString uri;      // shared cache memory database uri, so the target can attach it
+};
+
+inline QString StagingDatabase::connectionName() const     { return connName; }
+inline QString StagingDatabase::databaseUri() const        { return uri; }
+
+#endif // STAGINGDATABASE_H
@@ -0,0 +1,110 @@
+#include "TraceLog.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QThread>
+
+TraceLog::TraceLog()
+   : enabled(0)
+{
+}
+
+void TraceLog::start()
+{
+   QMutexLocker lock(&mutex);
+   events.clear();
+   threads.clear();
+   // whoever starts the log is "main" (not whichever thread happens to finish a span first)
+   threads.insert(quintptr(QThread::currentThreadId()), 1);
+   clock.start();
+   enabled.storeRelease(1);
+}
+
+void TraceLog::stop()
+{
+   QMutexLocker lock(&mutex);
+   enabled.storeRelease(0);
+}
+
+qint64 TraceLog::now() const
+{
+   return clock.nsecsElapsed() / 1000;
+}
+
+void TraceLog::addSpan(const QString& name, const QString& category, const qint64 start, const qint64 duration, const Args& args)
+{
+   const quintptr threadId = quintptr(QThread::currentThreadId());
+   QMutexLocker lock(&mutex);
+   if (!isEnabled()) return;
+   QHash<quintptr, int>::const_iterator it = threads.constFind(threadId);
+   if (it == threads.constEnd()) it = threads.insert(threadId, threads.size() + 1);
+   Event event = { name, category, start, duration, it.value(), args };
+   events << event;
+}
+
+bool TraceLog::write(const QString& fileName) const
+{
+   QMutexLocker lock(&mutex);
+   const qint64 pid = QCoreApplication::applicationPid();
+   QJsonArray array;
+   for (QHash<quintptr, int>::const_iterator it = threads.constBegin(); it != threads.constEnd(); ++it) {
+      QJsonObject threadName;
+      threadName.insert("name", it.value() == 1 ? QString("main") : QString("worker %1").arg(it.value() - 1));
+      QJsonObject meta;
+      meta.insert("ph", QString("M"));
+      meta.insert("name", QString("thread_name"));
+      meta.insert("pid", pid);
+      meta.insert("tid", it.value());
+      meta.insert("args", threadName);
+      array.append(meta);
+   }
+   for (int i = 0; i < events.size(); i++) {
+      const Event& e = events[i];
+      QJsonObject event;
+      event.insert("ph", QString("X"));
+      event.insert("name", e.name);
+      event.insert("cat", e.category);
+      event.insert("ts", e.start);
+      event.insert("dur", e.duration);
+      event.insert("pid", pid);
+      event.insert("tid", e.thread);
+      if (!e.args.isEmpty()) {
+         QJsonObject args;
+         for (int a = 0; a < e.args.size(); a++) args.insert(e.args[a].first, QJsonValue::fromVariant(e.args[a].second));
+         event.insert("args", args);
+      }
+      array.append(event);
+   }
+   QJsonObject trace;
+   trace.insert("traceEvents", array);
+   trace.insert("displayTimeUnit", QString("ms"));
+
+   QFile file(fileName);
+   if (!file.open(QFile::WriteOnly | QFile::Truncate)) return false;
+   const QByteArray json = QJsonDocument(trace).toJson(QJsonDocument::Compact);
+   return (file.write(json) == json.size());
+}
+
+TraceSpan::TraceSpan(TraceLog& l, const QString& n, const QString& c)
+   : log(l), start(-1)
+{
+   if (log.isEnabled()) {
+      name = n;
+      category = c;
+      start = log.now();
+   }
+}
+
+TraceSpan::~TraceSpan()
+{
+   if (start >= 0) log.addSpan(name, category, start, log.now() - start, args);
+}
+
+void TraceSpan::arg(const QString& n, const QVariant& value)
+{
+   if (start >= 0) args << qMakePair(n, value);
+}
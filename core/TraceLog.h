@@ -0,0 +1,75 @@
+// records timed spans, and writes them as a Chrome/Perfetto trace
+#ifndef TRACELOG_H
+#define TRACELOG_H
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+// The trace event format ("X" complete events, plus a thread_name for each thread), so a run can be
+// opened in chrome://tracing or ui.perfetto.dev to see where the time went, file by file.  Spans can
+// be recorded from any thread.  A disabled log records nothing, so spans cost next to nothing when
+// we aren't tracing.
+class TraceLog
+{
+public:
+   typedef QList< QPair<QString, QVariant> > Args;
+
+   TraceLog();
+
+   // clears the log and starts recording (times are from now, and the calling thread is "main")
+   void start();
+   void stop();
+   bool isEnabled() const;
+
+   // microseconds since start()
+   qint64 now() const;
+   void addSpan(const QString& name, const QString& category, const qint64 start, const qint64 duration, const Args& args);
+
+   bool write(const QString& fileName) const;
+
+private:
+   struct Event {
+      QString name;
+      QString category;
+      qint64 start;
+      qint64 duration;
+      int thread;
+      Args args;
+   };
+
+   mutable QMutex mutex;
+   QAtomicInt enabled;                 // (read by every span, without the mutex)
+   QElapsedTimer clock;
+   QVector<Event> events;
+   QHash<quintptr, int> threads;       // thread id -> our (small) thread number, 1 for start()'s
+};
+
+inline bool TraceLog::isEnabled() const      { return enabled.loadAcquire() != 0; }
+
+// Records a span from construction to destruction (if the log is enabled)
+class TraceSpan
+{
+public:
+   TraceSpan(TraceLog& log, const QString& name, const QString& category);
+   ~TraceSpan();
+
+   void arg(const QString& name, const QVariant& value);
+
+private:
+   Q_DISABLE_COPY(TraceSpan)
+
+   TraceLog& log;
+   QString name;
+   QString category;
+   qint64 start;
+   TraceLog::Args args;
+};
+
+#endif // TRACELOG_H
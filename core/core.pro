@@ -0,0 +1,15 @@
+# parsing, schema and storage - no widgets, so tools can link it without a display
+TEMPLATE        = lib
+TARGET          = oeSqlCore
+
+QT              = core sql
+
+CONFIG          += staticlib
+
+HEADERS         = *.h
+SOURCES         = *.cpp
+
+DESTDIR         = ../lib
+
+OBJECTS_DIR = ./tmp/obj
+MOC_DIR = ./tmp/moc
@@ -1,16 +1,5 @@
-TEMPLATE        = app
-TARGET          = oeSql
+# the parser and database code (core, QtCore/QtSql only), and the browser application built on it
+TEMPLATE        = subdirs
 
-QT              += sql widgets
-
-CONFIG          += console
-
-HEADERS         = *.h
-SOURCES         = *.cpp
-
-FORMS           = *.ui
-
-OBJECTS_DIR = ./tmp/obj
-MOC_DIR = ./tmp/moc
-RCC_DIR = ./tmp/rcc
-UI_DIR =  ./tmp/ui
+SUBDIRS         = core app
+app.depends     = core